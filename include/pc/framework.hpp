@@ -16,15 +16,71 @@
 #define PCFW_API
 #endif
 
+#include <cstddef>
+
 namespace PC::Framework
 {
 	typedef struct window window;
+	typedef struct scheduler scheduler;
+	typedef struct program_cache program_cache;
+	typedef struct command_buffer command_buffer;
 	typedef void (*framebuffer_size_callback)(window *window, int width, int height);
 	typedef void (*mouse_callback)(int mouse_button, int status, int mods);
 	typedef void *(*proc)(const char *name);
 	typedef void (*key_callback)(int key, int scancode, int action, int mods);
+	typedef void (*refresh_callback)(window *window);
+	// Receives the clipboard in chunks with `CLIPBOARD_DATA`, then `CLIPBOARD_DONE` or `CLIPBOARD_FAILED`. The data is valid only during the call
+	typedef void (*clipboard_callback)(window *window, const void *data, size_t size, int status, void *user_data);
 	int set_key_callback(window* window, key_callback callback);
 
+    // Gamepads
+
+    constexpr int GAMEPAD_MAX = 8;
+    constexpr int GAMEPAD_BUTTON_COUNT = 15;
+    constexpr int GAMEPAD_AXIS_COUNT = 8;
+
+    // A monitor, as reported by `get_monitors`
+    struct monitor
+    {
+        char name[64];
+        // Identifier of the monitor in the display server, e.g. the XRandR output
+        unsigned long id;
+        int x, y, width, height;
+        int width_mm, height_mm;
+        // In Hz, `0.0` if unknown
+        double refresh_rate;
+        bool primary;
+    };
+
+    // An event of a window, as received by `next_event` of `framework_coroutine.hpp`
+    struct event
+    {
+        // One of `EVENT_*`
+        int type;
+        // `EVENT_KEY`, like the arguments of `key_callback`
+        int key, scancode, action;
+        // `EVENT_MOUSE_BUTTON`, like the arguments of `mouse_callback`
+        int button, status;
+        int mods;
+        // `EVENT_RESIZE`
+        int width, height;
+        // `EVENT_MOUSE_MOTION` and `EVENT_ENTER_LEAVE`, the cursor in window coordinates
+        int x, y;
+        // `EVENT_ENTER_LEAVE` and `EVENT_FOCUS`, `1` when the cursor entered or the focus came, `0` when they left
+        int active;
+    };
+
+    // Snapshot of a gamepad, as of the last `poll_events`
+    struct gamepad_state
+    {
+        bool connected;
+        char name[128];
+        // `1` if pressed. Indexed by `GAMEPAD_BUTTON_*`
+        unsigned char buttons[GAMEPAD_BUTTON_COUNT];
+        // From `-1.0` to `1.0`, triggers from `0.0` to `1.0`. Indexed by `GAMEPAD_AXIS_*`
+        float axes[GAMEPAD_AXIS_COUNT];
+    };
+
 	// Gets the OpenGL proc address
 	PCFW_API void *get_proc_address(const char *proc);
 
@@ -91,6 +147,76 @@ namespace PC::Framework
      */
     PCFW_API void poll_events(window *window);
 
+    /**
+     * @brief Sleeps until an event arrives or a redraw is requested, then handles the events like `poll_events`.
+     * It returns at once while a redraw is pending, so loops that draw only after `needs_redraw` use no CPU nor GPU between changes
+     * @param window What waits for the events
+     */
+    PCFW_API void wait_events(window *window);
+
+    /**
+     * @brief Like `wait_events`, but sleeping at most `timeout` seconds, e.g. until the next frame of an animation
+     * @param window What waits for the events
+     * @param timeout The seconds
+     */
+    PCFW_API void wait_events_timeout(window *window, double timeout);
+
+    /**
+     * @brief Asks for a redraw, waking `wait_events` up, or an external loop waiting for the fds of `get_event_fds`. It can be called from any thread
+     * @param window What has to be redrawn
+     */
+    PCFW_API void request_redraw(window *window);
+
+    /**
+     * @brief Tells if the window has to be redrawn and clears it. Input, resizes, exposes and `request_redraw` set it, and new windows start with it
+     * @param window What may have to be redrawn
+     * @return `1` if it has to be redrawn
+     */
+    PCFW_API int needs_redraw(window *window);
+
+    /**
+     * @brief Gets the fd of the display connection, to wait for it in another event loop instead of `poll_events`.
+     * Before sleeping call `prepare_events`, and after waking call `check_events`. `request_redraw` and the gamepads
+     * don't wake this fd, wait for the fds of `get_event_fds` to have them too
+     * @param window What has the connection
+     * @return The fd. Wait for it to be readable
+     */
+    PCFW_API int get_event_fd(window *window);
+
+    // The display, the eventfd of `request_redraw`, the gamepad hotplug watch and each gamepad
+    constexpr int EVENT_FD_MAX = 3 + GAMEPAD_MAX;
+
+    /**
+     * @brief Gets every fd the window has to wake up for: the display connection, the eventfd of `request_redraw` and
+     * the gamepads once they're used. The gamepad fds change when gamepads are plugged, so get them again after each
+     * `check_events`
+     * @param window What has the fds
+     * @param fds Receives the fds. Wait for any of them to be readable, `check_events` handles them all
+     * @param max The size of `fds`, `EVENT_FD_MAX` fits every fd
+     * @return How many fds were written
+     */
+    PCFW_API int get_event_fds(window *window, int *fds, int max);
+
+    /**
+     * @brief Handles the events that were already read, without reading the connection
+     * @param window What has the events
+     */
+    PCFW_API void dispatch_pending(window *window);
+
+    /**
+     * @brief Sends the requests that are waiting, so the loop can sleep on the fd
+     * @param window What has the connection
+     * @return `1` if events are already read. Call `dispatch_pending` and prepare again instead of sleeping
+     */
+    PCFW_API int prepare_events(window *window);
+
+    /**
+     * @brief Reads and handles the events after the loop woke up. It never blocks, and it's needed after every `prepare_events` that returned `0`.
+     * It services every fd of `get_event_fds`: the display, `request_redraw` and the gamepads
+     * @param window What has the connection
+     */
+    PCFW_API void check_events(window *window);
+
     /**
      * @brief Sets the framebuffer size callback
      * @param window What that will receive the callback
@@ -99,6 +225,14 @@ namespace PC::Framework
      */
     PCFW_API int set_framebuffer_size_callback(window *window, framebuffer_size_callback callback);
 
+    /**
+     * @brief Sets the callback that redraws a window while it's resized or exposed. It's called inside `poll_events`,
+     * draw and call `swap_buffers` in it, so the window manager resizes at the pace the frames are made
+     * @param window What will receive the callback
+     * @param callback The callback
+     */
+    PCFW_API int set_window_refresh_callback(window *window, refresh_callback callback);
+
     /**
      * @brief Sets the mouse callback
      * @param window What will receive the callback
@@ -106,6 +240,14 @@ namespace PC::Framework
      */
     PCFW_API int set_mouse_callback(window *window, mouse_callback callback);
 
+    /**
+     * @brief Chooses the events a window receives. Events of the callbacks that are set are always received. Motion,
+     * crossings and focus changes are posted as `EVENT_*` to the waiters of `next_event`
+     * @param window What will receive the events
+     * @param events The `EVENTS_*` or-ed. Windows start with `EVENTS_KEY`, for `get_key`
+     */
+    PCFW_API int subscribe_events(window *window, int events);
+
     /**
      * @brief Sets the swap interval of a window
      * @param window What that will be intervaled
@@ -114,6 +256,28 @@ namespace PC::Framework
      */
     PCFW_API void set_swap_interval(window *window, int interval);
 
+    /**
+     * @brief Limits how often `swap_buffers` returns. It sleeps most of the wait and spins the end, so the frames stay even
+     * @param window What will be limited
+     * @param frame_rate The frames per second, or `0.0` for no limit
+     */
+    PCFW_API void set_target_frame_rate(window *window, double frame_rate);
+
+    /**
+     * @brief Gets if the window can be seen. Partly covered windows are visible
+     * @param window What may be seen
+     * @return One of `VISIBILITY_*`. Wayland windows are always visible, their compositor throttles the hidden ones itself
+     */
+    PCFW_API int get_window_visibility(window *window);
+
+    /**
+     * @brief Limits how often `swap_buffers` returns while the window can't be seen. Minimized and unmapped windows also skip the swap itself.
+     * Windows start with 10 frames per second. In a scheduler only the swaps are skipped, the others would wait for the sleep too
+     * @param window What will be limited
+     * @param frame_rate The frames per second, or `0.0` to swap them like visible windows
+     */
+    PCFW_API void set_hidden_frame_rate(window *window, double frame_rate);
+
     /**
      * @brief Detects if a window should close
      * @param window What will be detected
@@ -135,10 +299,451 @@ namespace PC::Framework
      */
     PCFW_API int get_cursor_position(window *window, int *x, int *y);
 
+    /**
+     * @brief Gets the monitors. They're cached and updated by `poll_events` when the monitors change
+     * @param window What display the monitors will be got from
+     * @param count The variable that the number of monitors will be storaged
+     * @return The monitors, the primary one first. Valid until the next `poll_events`
+     */
+    PCFW_API const monitor *get_monitors(window *window, int *count);
+
+    /**
+     * @brief Gets the monitor that has most of a window
+     * @param window What will be looked for
+     * @return The number of the monitor in `get_monitors`, or `MONITOR_NONE`
+     */
+    PCFW_API int get_window_monitor(window *window);
+
+    /**
+     * @brief Makes a window fullscreen on a monitor, asking the compositor to stop compositing it
+     * @param window What will be fullscreen
+     * @param monitor The number of the monitor, `0` is the primary one. `MONITOR_NONE` makes the window windowed again
+     */
+    PCFW_API int set_window_fullscreen(window *window, int monitor);
+
+    /**
+     * @brief Makes a window fullscreen and switches the video mode of the monitor. The mode is restored when the window leaves fullscreen
+     * @param window What will be fullscreen
+     * @param monitor The number of the monitor, `0` is the primary one
+     * @param width The width of the mode
+     * @param height The height of the mode
+     * @param refresh_rate The refresh rate of the mode in Hz. `0` picks the highest one
+     */
+    PCFW_API int set_window_fullscreen_mode(window *window, int monitor, int width, int height, double refresh_rate);
+
+    /**
+     * @brief Sets the clipboard. Large data is sent in chunks to the applications that paste it
+     * @param window What will own the clipboard
+     * @param type The type of the data. e.g., `UTF8_STRING` or `image/png`. `nullptr` is `UTF8_STRING`
+     * @param data The data, copied once
+     * @param size The size of the data in bytes
+     */
+    PCFW_API int set_clipboard(window *window, const char *type, const void *data, size_t size);
+
+    /**
+     * @brief Asks for the clipboard. It's received by the callback during the next `poll_events`, without blocking.
+     * It fails if the owner sends nothing for 5 seconds
+     * @param window What will receive the clipboard
+     * @param type The type wanted. `nullptr` is `UTF8_STRING`
+     * @param callback What will receive the chunks
+     * @param user_data Given to the callback
+     */
+    PCFW_API int request_clipboard(window *window, const char *type, clipboard_callback callback, void *user_data);
+
+    /**
+     * @brief Gets the state of a gamepad. The gamepads are opened at the first call and updated by `poll_events`
+     * @param gamepad From `0` until `GAMEPAD_MAX - 1`
+     * @param state The variable that the state will be storaged
+     * @return `0` if the gamepad is connected
+     */
+    PCFW_API int get_gamepad_state(int gamepad, gamepad_state *state);
+
+    /**
+     * @brief Creates a scheduler that swaps several windows without waiting a V-Sync for each one
+     * @return A created scheduler
+     */
+    PCFW_API scheduler *create_scheduler();
+
+    /**
+     * @brief Destroys a scheduler. Its windows get their own swap interval back
+     * @param scheduler What that will be destroyed
+     */
+    PCFW_API int destroy_scheduler(scheduler *scheduler);
+
+    /**
+     * @brief Adds a window to a scheduler. The first window paces the others with its swap interval, the others swap with interval `0`
+     * @param scheduler What will receive the window
+     * @param window What will be swapped by the scheduler
+     */
+    PCFW_API int scheduler_add_window(scheduler *scheduler, window *window);
+
+    /**
+     * @brief Removes a window from a scheduler and gives its swap interval back
+     * @param scheduler What has the window
+     * @param window What will be removed
+     */
+    PCFW_API int scheduler_remove_window(scheduler *scheduler, window *window);
+
+    /**
+     * @brief Swaps every window of a scheduler. Call it once all of them were rendered. Each window's context is made
+     * current for its swap, and the one made current by `make_context_current` before is current again after it
+     * @param scheduler What has the windows
+     */
+    PCFW_API void scheduler_swap_buffers(scheduler *scheduler);
+
+    /**
+     * @brief Measures the GPU time of each frame of a window, from a `swap_buffers` to the next. The context must be current
+     * @param window What will be measured
+     * @param enabled `1` to start, `0` to stop
+     */
+    PCFW_API int set_gpu_timing(window *window, int enabled);
+
+    /**
+     * @brief Begins a named GPU scope of the current frame. Scopes can be nested
+     * @param window What has the frame
+     * @param name The name the time is got by
+     */
+    PCFW_API int begin_gpu_scope(window *window, const char *name);
+
+    /**
+     * @brief Ends the last GPU scope begun
+     * @param window What has the frame
+     */
+    PCFW_API int end_gpu_scope(window *window);
+
+    /**
+     * @brief Gets the GPU time of the last frame whose results arrived. They arrive some frames late, they're never waited
+     * @param window What was measured
+     * @param milliseconds The variable that the time will be storaged
+     * @return `1` if no frame has arrived yet
+     */
+    PCFW_API int get_gpu_frame_time(window *window, double *milliseconds);
+
+    /**
+     * @brief Gets the GPU time of a scope in the last frame whose results arrived
+     * @param window What was measured
+     * @param name The name given to `begin_gpu_scope`
+     * @param milliseconds The variable that the time will be storaged
+     * @return `1` if that frame hadn't the scope
+     */
+    PCFW_API int get_gpu_scope_time(window *window, const char *name, double *milliseconds);
+
+    // Frames in flight
+
+    // Most frames `set_max_frames_in_flight` lets the GPU be behind
+    constexpr int FRAMES_IN_FLIGHT_MAX = 8;
+
+    /**
+     * @brief Limits how many frames of a window the CPU may queue ahead of the GPU. After each `swap_buffers` a fence is
+     * inserted, and the fence from `frames` swaps back is waited before it returns. `1` waits every frame, more trade latency
+     * for throughput. The context must be current
+     * @param window What will be limited
+     * @param frames From `1` to `FRAMES_IN_FLIGHT_MAX`, or `0` to let the driver decide again
+     */
+    PCFW_API int set_max_frames_in_flight(window *window, int frames);
+
+    /**
+     * @brief Gets how long the last `swap_buffers` waited for the GPU to finish an older frame
+     * @param window What is limited
+     * @param milliseconds The variable that the time will be storaged
+     * @return `1` if the frames in flight aren't limited
+     */
+    PCFW_API int get_frame_fence_wait(window *window, double *milliseconds);
+
+    // Frame arenas
+
+    // Size of the first block of a frame arena, until `set_frame_arena` changes it
+    constexpr size_t FRAME_ARENA_BLOCK = 64 * 1024;
+
+    /**
+     * @brief Sets up the frame arenas of a window. It must be called before the first `frame_alloc`
+     * @param window What has the arenas
+     * @param block_size Bytes of the first block of each arena
+     * @param buffers `1` frees the memory at the next `swap_buffers`, `2` keeps it one more frame, for data the GPU may still read
+     */
+    PCFW_API int set_frame_arena(window *window, size_t block_size, int buffers);
+
+    /**
+     * @brief Allocates memory that lives until the next `swap_buffers` of the window, or the one after with two buffers.
+     * Each thread has its own arena, so it's a pointer bump without locks. Nothing is freed by hand
+     * @param window What has the arenas
+     * @param size The bytes
+     * @param alignment A power of two, e.g. `alignof(T)`
+     * @return The memory, or `nullptr` if it couldn't be allocated
+     */
+    PCFW_API void *frame_alloc(window *window, size_t size, size_t alignment);
+
+    /**
+     * @brief Gets the most bytes an arena of the window used in one frame. Once a frame needed more than the first block,
+     * the next frames get a single block of that size
+     * @param window What has the arenas
+     * @param bytes The variable that the bytes will be storaged
+     */
+    PCFW_API int get_frame_arena_high_water(window *window, size_t *bytes);
+
+    /**
+     * @brief Opens a cache of linked OpenGL programs in a directory. Binaries are kept per GPU and driver
+     * @param window What has the context. It's made current if it wasn't
+     * @param directory Where the binaries are stored. It's created if it doesn't exist
+     * @return The cache, or `nullptr` if the driver can't give program binaries
+     */
+    PCFW_API program_cache *create_program_cache(window *window, const char *directory);
+
+    /**
+     * @brief Closes a program cache. The binaries stay on disk
+     * @param cache What will be closed
+     */
+    PCFW_API int destroy_program_cache(program_cache *cache);
+
+    /**
+     * @brief Loads a program linked from some shader sources before
+     * @param cache Where the binary is looked for
+     * @param sources The shader sources, in the same order as when it was stored
+     * @param count The number of sources
+     * @return The linked program, or `0` if it must be compiled. Corrupt and outdated binaries are removed
+     */
+    PCFW_API unsigned int program_cache_load(program_cache *cache, const char *const *sources, int count);
+
+    /**
+     * @brief Stores the binary of a linked program. Set `GL_PROGRAM_BINARY_RETRIEVABLE_HINT` before linking it
+     * @param cache Where the binary will be stored
+     * @param sources The shader sources of the program
+     * @param count The number of sources
+     * @param program The linked program
+     */
+    PCFW_API int program_cache_store(program_cache *cache, const char *const *sources, int count, unsigned int program);
+
+    /**
+     * @brief Creates a buffer of OpenGL commands. Any thread can record it without a context, one thread at a time,
+     * and the thread with the context replays it. Its memory is kept between frames
+     * @return The command buffer
+     */
+    PCFW_API command_buffer *create_command_buffer();
+
+    /**
+     * @brief Destroys a command buffer. It mustn't be submitted and waiting for `swap_buffers`
+     * @param buffer What will be destroyed
+     */
+    PCFW_API int destroy_command_buffer(command_buffer *buffer);
+
+    /**
+     * @brief Removes the commands, keeping the memory for the next ones
+     * @param buffer What will be emptied
+     */
+    PCFW_API int reset_command_buffer(command_buffer *buffer);
+
+    /**
+     * @brief Records `glUseProgram`
+     * @param buffer Where the command is recorded
+     * @param program The program
+     */
+    PCFW_API int command_use_program(command_buffer *buffer, unsigned int program);
+
+    /**
+     * @brief Records `glBindVertexArray`
+     * @param buffer Where the command is recorded
+     * @param vertex_array The vertex array
+     */
+    PCFW_API int command_bind_vertex_array(command_buffer *buffer, unsigned int vertex_array);
+
+    /**
+     * @brief Records `glActiveTexture` and `glBindTexture`
+     * @param buffer Where the command is recorded
+     * @param unit The texture unit, from `0`
+     * @param target The target, e.g. `GL_TEXTURE_2D`
+     * @param texture The texture
+     */
+    PCFW_API int command_bind_texture(command_buffer *buffer, unsigned int unit, unsigned int target, unsigned int texture);
+
+    /**
+     * @brief Records `glUniform1i`
+     * @param buffer Where the command is recorded
+     * @param location The uniform location
+     * @param value The value
+     */
+    PCFW_API int command_uniform_int(command_buffer *buffer, int location, int value);
+
+    /**
+     * @brief Records `glUniform1fv` to `glUniform4fv`. The values are copied
+     * @param buffer Where the command is recorded
+     * @param location The uniform location
+     * @param components From `1` to `4`
+     * @param values The values
+     */
+    PCFW_API int command_uniform_float(command_buffer *buffer, int location, int components, const float *values);
+
+    /**
+     * @brief Records `glUniformMatrix4fv` of one column-major matrix. It's copied
+     * @param buffer Where the command is recorded
+     * @param location The uniform location
+     * @param matrix The 16 values
+     */
+    PCFW_API int command_uniform_matrix(command_buffer *buffer, int location, const float *matrix);
+
+    /**
+     * @brief Records `glViewport`
+     * @param buffer Where the command is recorded
+     * @param x The left edge, in pixels
+     * @param y The bottom edge, in pixels
+     * @param width The width, in pixels
+     * @param height The height, in pixels
+     */
+    PCFW_API int command_viewport(command_buffer *buffer, int x, int y, int width, int height);
+
+    /**
+     * @brief Records `glDrawArrays`, or `glDrawArraysInstanced` for more than one instance
+     * @param buffer Where the command is recorded
+     * @param mode The primitives, e.g. `GL_TRIANGLES`
+     * @param first The first vertex
+     * @param count The number of vertices
+     * @param instances The number of instances
+     */
+    PCFW_API int command_draw_arrays(command_buffer *buffer, unsigned int mode, int first, int count, int instances);
+
+    /**
+     * @brief Records `glDrawElements`, or `glDrawElementsInstanced` for more than one instance
+     * @param buffer Where the command is recorded
+     * @param mode The primitives, e.g. `GL_TRIANGLES`
+     * @param count The number of indices
+     * @param type The type of the indices, e.g. `GL_UNSIGNED_INT`
+     * @param offset Where the indices start in the bound element buffer, in bytes
+     * @param instances The number of instances
+     */
+    PCFW_API int command_draw_elements(command_buffer *buffer, unsigned int mode, int count, unsigned int type, size_t offset, int instances);
+
+    /**
+     * @brief Records a call of a function, for what the other commands don't do. It's called by the thread that replays the buffer
+     * @param buffer Where the command is recorded
+     * @param callback The function
+     * @param user_data What the function receives
+     */
+    PCFW_API int command_callback(command_buffer *buffer, void (*callback)(void *user_data), void *user_data);
+
+    /**
+     * @brief Queues a command buffer to be replayed by the next `swap_buffers` of the window, after the ones queued before.
+     * Any thread can queue. The buffer mustn't be changed until that `swap_buffers` returns
+     * @param window What will replay it
+     * @param buffer What will be replayed
+     */
+    PCFW_API int submit_command_buffer(window *window, command_buffer *buffer);
+
+    /**
+     * @brief Replays a command buffer now. The context must be current on this thread
+     * @param buffer What will be replayed
+     */
+    PCFW_API int execute_command_buffer(command_buffer *buffer);
+
+    /**
+     * @brief Starts or stops recording the spans of the framework, e.g. event handling and swaps
+     * @param enabled `1` to start, `0` to stop
+     */
+    PCFW_API void set_tracing(int enabled);
+
+    /**
+     * @brief Writes the spans recorded since the last call as a Chrome trace, that Perfetto and chrome://tracing open.
+     * The buffers of the threads that exited are freed after their spans are written
+     * @param path The JSON file
+     */
+    PCFW_API int write_trace(const char *path);
+
+    /**
+     * @brief Sets a hint for the windows created after it
+     * @param hint It can be `HINT_CLIENT_API`
+     * @param value The value of the hint. e.g., `CLIENT_API_NONE` for a window without OpenGL context
+     */
+    PCFW_API void window_hint(int hint, int value);
+
+    /**
+     * @brief Gets the Vulkan instance extensions needed by `create_vulkan_surface`
+     * @param count The variable that the number of extensions will be storaged
+     * @return The names of the extensions
+     */
+    PCFW_API const char **get_required_instance_extensions(unsigned int *count);
+
+#ifdef VK_VERSION_1_0
+    /**
+     * @brief Creates a Vulkan surface for a window created with `CLIENT_API_NONE`
+     * @param instance The instance created with `get_required_instance_extensions`
+     * @param window What the surface will present to
+     * @param surface The variable that the surface will be storaged
+     * @return `0` if the surface was created
+     */
+    PCFW_API int create_vulkan_surface(VkInstance instance, window *window, VkSurfaceKHR *surface);
+#endif
+
     // Constants
     
     constexpr int DONT_CARE = -1;
 
+    // Hints
+
+    constexpr int HINT_CLIENT_API = 1;
+
+    constexpr int CLIENT_API_OPENGL = 0;
+    constexpr int CLIENT_API_NONE = 1;
+
+    // Event categories of `subscribe_events`
+
+    constexpr int EVENTS_KEY = 1 << 0;
+    constexpr int EVENTS_MOUSE_BUTTON = 1 << 1;
+    constexpr int EVENTS_MOUSE_MOTION = 1 << 2;
+    constexpr int EVENTS_ENTER_LEAVE = 1 << 3;
+    constexpr int EVENTS_FOCUS = 1 << 4;
+    constexpr int EVENTS_EXPOSE = 1 << 5;
+
+    // Events of `event`. They're or-ed in the filters
+
+    constexpr int EVENT_KEY = 1 << 0;
+    constexpr int EVENT_MOUSE_BUTTON = 1 << 1;
+    constexpr int EVENT_RESIZE = 1 << 2;
+    constexpr int EVENT_CLOSE = 1 << 3;
+    // Only sent to windows subscribed to `EVENTS_MOUSE_MOTION`, `EVENTS_ENTER_LEAVE` and `EVENTS_FOCUS`
+    constexpr int EVENT_MOUSE_MOTION = 1 << 4;
+    constexpr int EVENT_ENTER_LEAVE = 1 << 5;
+    constexpr int EVENT_FOCUS = 1 << 6;
+    constexpr int EVENT_ANY = EVENT_KEY | EVENT_MOUSE_BUTTON | EVENT_RESIZE | EVENT_CLOSE | EVENT_MOUSE_MOTION | EVENT_ENTER_LEAVE | EVENT_FOCUS;
+
+    // Visibility of `get_window_visibility`
+
+    constexpr int VISIBILITY_VISIBLE = 0;
+    constexpr int VISIBILITY_OBSCURED = 1;
+    constexpr int VISIBILITY_HIDDEN = 2;
+
+    // Monitors
+
+    constexpr int MONITOR_NONE = -1;
+
+    // Clipboard
+
+    constexpr int CLIPBOARD_DATA = 0;
+    constexpr int CLIPBOARD_DONE = 1;
+    constexpr int CLIPBOARD_FAILED = 2;
+
+    // Gamepad buttons and axes
+
+    constexpr int GAMEPAD_BUTTON_SOUTH = 0;
+    constexpr int GAMEPAD_BUTTON_EAST = 1;
+    constexpr int GAMEPAD_BUTTON_NORTH = 3;
+    constexpr int GAMEPAD_BUTTON_WEST = 4;
+    constexpr int GAMEPAD_BUTTON_LEFT_BUMPER = 6;
+    constexpr int GAMEPAD_BUTTON_RIGHT_BUMPER = 7;
+    constexpr int GAMEPAD_BUTTON_LEFT_TRIGGER = 8;
+    constexpr int GAMEPAD_BUTTON_RIGHT_TRIGGER = 9;
+    constexpr int GAMEPAD_BUTTON_SELECT = 10;
+    constexpr int GAMEPAD_BUTTON_START = 11;
+    constexpr int GAMEPAD_BUTTON_GUIDE = 12;
+    constexpr int GAMEPAD_BUTTON_LEFT_THUMB = 13;
+    constexpr int GAMEPAD_BUTTON_RIGHT_THUMB = 14;
+
+    constexpr int GAMEPAD_AXIS_LEFT_X = 0;
+    constexpr int GAMEPAD_AXIS_LEFT_Y = 1;
+    constexpr int GAMEPAD_AXIS_LEFT_TRIGGER = 2;
+    constexpr int GAMEPAD_AXIS_RIGHT_X = 3;
+    constexpr int GAMEPAD_AXIS_RIGHT_Y = 4;
+    constexpr int GAMEPAD_AXIS_RIGHT_TRIGGER = 5;
+    constexpr int GAMEPAD_AXIS_HAT_X = 6;
+    constexpr int GAMEPAD_AXIS_HAT_Y = 7;
+
     // Keys
 
     constexpr int KEY_PRESS = 0;
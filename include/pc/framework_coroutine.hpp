@@ -0,0 +1,139 @@
+// Author: oknauta
+// License: MIT
+// File: framework_coroutine.hpp
+// Date: 2026-10-19
+
+// Coroutines driven by `poll_events` and `swap_buffers`. Needs C++20 and pcfw built with `PCFW_COROUTINES`
+
+#ifndef PCFW_COROUTINE_HPP
+#define PCFW_COROUTINE_HPP
+
+#include "framework.hpp"
+#include <coroutine>
+#include <cstddef>
+
+namespace PC::Framework
+{
+    /**
+     * @brief The return type of the coroutines. They start when called and nobody has to keep the task.
+     * They're resumed inside `poll_events` and `swap_buffers`, so they mustn't call them nor destroy their window.
+     * Destroying a window destroys the coroutines waiting for it
+     */
+    struct task
+    {
+        struct promise_type
+        {
+            task get_return_object() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {
+            }
+
+            PCFW_API void unhandled_exception() noexcept;
+
+            // The frames come from a pool, so starting a coroutine rarely allocates and resuming never does
+            PCFW_API static void *operator new(std::size_t size);
+            PCFW_API static void operator delete(void *pointer, std::size_t size);
+        };
+    };
+
+    // What `next_frame` returns
+    struct frame_awaiter
+    {
+        window *_window;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        PCFW_API void await_suspend(std::coroutine_handle<> handle);
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    // What `next_event` returns
+    struct event_awaiter
+    {
+        window *_window;
+        int _filter;
+        event _event;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        PCFW_API void await_suspend(std::coroutine_handle<> handle);
+
+        event await_resume() const noexcept
+        {
+            return _event;
+        }
+    };
+
+    // What `wait_timeout` returns
+    struct timeout_awaiter
+    {
+        window *_window;
+        double _seconds;
+
+        bool await_ready() const noexcept
+        {
+            return _seconds <= 0.0;
+        }
+
+        PCFW_API void await_suspend(std::coroutine_handle<> handle);
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    /**
+     * @brief Waits until the next `swap_buffers` of a window returns
+     * @param window What swaps
+     */
+    inline frame_awaiter next_frame(window *window)
+    {
+        return {window};
+    }
+
+    /**
+     * @brief Waits for an event of a window. The events are subscribed if they weren't
+     * @param window What receives the event
+     * @param filter The `EVENT_*` or-ed
+     * @return The event, from `co_await`
+     */
+    inline event_awaiter next_event(window *window, int filter = EVENT_ANY)
+    {
+        return {window, filter, {}};
+    }
+
+    /**
+     * @brief Waits some time. It's checked by `poll_events` and `swap_buffers` of a window, so it ends on one of them
+     * @param window What checks the time
+     * @param seconds How long
+     */
+    inline timeout_awaiter wait_timeout(window *window, double seconds)
+    {
+        return {window, seconds};
+    }
+} // namespace PCFW
+
+#endif // PCFW_COROUTINE_HPP
@@ -10,10 +10,20 @@
 
 #include "framework.hpp"
 #include <X11/X.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #ifdef __linux__
 #include <X11/Xlib.h>
+#include <X11/Xlib-xcb.h>
+#include <X11/extensions/Xrandr.h>
+#include <X11/extensions/sync.h>
+#include <xcb/xcb.h>
 #include <GL/glx.h>
+#include <poll.h>
 #endif
 
 #ifdef _WIN32
@@ -21,8 +31,109 @@
 #include <windows.h>
 #endif
 
+// Validation level of the public functions: `0` strips the checks, `1` logs and aborts and `2` logs.
+// When it isn't defined at build time, release builds (`NDEBUG`) strip the checks
+#ifndef PCFW_VALIDATION_LEVEL
+#ifdef NDEBUG
+#define PCFW_VALIDATION_LEVEL 0
+#else
+#define PCFW_VALIDATION_LEVEL 2
+#endif
+#endif
+
+// Checks `condition` at the level above. It evaluates to `true` when the condition holds or the checks are stripped.
+// Every use gets its own counter, so a misuse inside a loop is logged a few times and then only at powers of two
+#define PCFW_VALIDATE(condition, message) \
+	(::PC::Framework::VALIDATION_LEVEL == ::PC::Framework::VALIDATION_OFF || (condition) || \
+	 ::PC::Framework::INTERNAL_validation_failed([]() -> ::PC::Framework::INTERNAL_validation_site & { static ::PC::Framework::INTERNAL_validation_site _site; return _site; }(), message))
+
+// Records a span from here to the end of the scope while tracing is on. Built only with `PCFW_TRACE`
+#ifdef PCFW_TRACE
+#define PCFW_TRACE_CONCAT_(a, b) a##b
+#define PCFW_TRACE_CONCAT(a, b) PCFW_TRACE_CONCAT_(a, b)
+#define PCFW_TRACE_SCOPE(name) ::PC::Framework::INTERNAL_trace_scope PCFW_TRACE_CONCAT(_trace_scope_, __LINE__)(name)
+#else
+#define PCFW_TRACE_SCOPE(name)
+#endif
+
 namespace PC::Framework
 {
+	constexpr int VALIDATION_OFF = 0;
+	constexpr int VALIDATION_ASSERT = 1;
+	constexpr int VALIDATION_LOG = 2;
+
+	constexpr int VALIDATION_LEVEL = PCFW_VALIDATION_LEVEL;
+
+	// How many times a call site logs before it's rate-limited
+	constexpr unsigned int VALIDATION_LOG_BURST = 4;
+
+	// Per call site state of `PCFW_VALIDATE`
+	struct INTERNAL_validation_site
+	{
+		std::atomic<unsigned int> _count{0};
+	};
+
+	// Reports a failed validation. Always returns `false`
+	PCFW_API bool INTERNAL_validation_failed(INTERNAL_validation_site &site, const char *message);
+
+	// Tracing, in `framework_trace.cpp`. Spans keep the name pointer, so names must be literals
+	PCFW_API extern std::atomic<bool> INTERNAL_tracing;
+	PCFW_API long long INTERNAL_trace_time();
+	PCFW_API void INTERNAL_trace_span(const char *name, long long begin, long long end);
+	PCFW_API int INTERNAL_write_trace(const char *path);
+
+	// Span of `PCFW_TRACE_SCOPE`. When tracing is off it costs a relaxed load
+	struct INTERNAL_trace_scope
+	{
+		const char *_name;
+		long long _begin;
+
+		explicit INTERNAL_trace_scope(const char *name) : _name(name), _begin(INTERNAL_tracing.load(std::memory_order_relaxed) ? INTERNAL_trace_time() : 0)
+		{
+		}
+
+		~INTERNAL_trace_scope()
+		{
+			if (_begin)
+			{
+				INTERNAL_trace_span(_name, _begin, INTERNAL_trace_time());
+			}
+		}
+	};
+
+	// Gives an event to what waits for it. The backends call it after the callbacks
+	PCFW_API void INTERNAL_post_event(window *window, const event &event);
+
+#ifdef PCFW_COROUTINES
+	// Coroutines waiting for a window, in `framework_coroutine.cpp`
+	struct INTERNAL_coroutines;
+
+	void INTERNAL_resume_frame_waiters(window *window);
+	void INTERNAL_resume_event_waiters(window *window, const event &event);
+	void INTERNAL_resume_timers(window *window);
+	// The timeout of `wait_events` in milliseconds, shortened to the nearest timer. `-1` waits forever
+	int INTERNAL_clamp_to_timers(window *window, int timeout);
+	void INTERNAL_destroy_coroutines(window *window);
+#endif
+
+	// Frame arenas of a window, in `framework_frame_arena.cpp`. Each thread gets its own arena the first time it allocates
+	struct INTERNAL_frame_arena;
+
+	struct INTERNAL_frame_arenas
+	{
+		std::mutex _mutex;
+		std::vector<INTERNAL_frame_arena *> _arenas;
+		// Advanced by `swap_buffers`. An arena resets its buffer when it sees a new frame, so nothing walks the threads
+		std::atomic<unsigned long long> _frame;
+		// Tells the window from an older one at the same address, for the arena each thread remembers
+		unsigned long long _id;
+		size_t _block_size;
+		int _buffers;
+	};
+
+	void INTERNAL_init_frame_arenas(window *window);
+	void INTERNAL_free_frame_arenas(window *window);
+
 	// Internal functions
 	PCFW_API int INTERNAL_create_window(window *window);
 	PCFW_API int INTERNAL_destroy_window(window *window);
@@ -30,12 +141,222 @@ namespace PC::Framework
 	PCFW_API int INTERNAL_set_mouse_callback(window *window, mouse_callback callback);
 	PCFW_API int INTERNAL_set_key_callback(window *window, key_callback callback);
 	PCFW_API int INTERNAL_set_framebuffer_size_callback(window *window, framebuffer_size_callback callback);
+	PCFW_API int INTERNAL_subscribe_events(window *window, int events);
+	PCFW_API int INTERNAL_set_window_refresh_callback(window *window, refresh_callback callback);
 	PCFW_API bool INTERNAL_window_should_close(window *window);
 	PCFW_API void INTERNAL_poll_events(window *window);
+	PCFW_API int INTERNAL_get_event_fd(window *window);
+	PCFW_API int INTERNAL_get_event_fds(window *window, int *fds, int max);
+	PCFW_API void INTERNAL_dispatch_pending(window *window);
+	PCFW_API int INTERNAL_prepare_events(window *window);
+	PCFW_API void INTERNAL_check_events(window *window);
+	PCFW_API void INTERNAL_wait_events(window *window, int timeout);
+	PCFW_API void INTERNAL_request_redraw(window *window);
+	PCFW_API int INTERNAL_needs_redraw(window *window);
 	PCFW_API void INTERNAL_swap_buffers(window *window);
 	PCFW_API void INTERNAL_set_swap_interval(window *window, int interval);
+	PCFW_API void INTERNAL_set_target_frame_rate(window *window, double frame_rate);
+	PCFW_API int INTERNAL_get_window_visibility(window *window);
+	PCFW_API void INTERNAL_set_hidden_frame_rate(window *window, double frame_rate);
+	PCFW_API void INTERNAL_wait_frame(window *window);
 	PCFW_API void INTERNAL_set_window_limits(window *window, int minimum_width, int minimum_height, int maximum_width, int maximum_height);
 	PCFW_API void *INTERNAL_get_proc_address(const char *proc);
+	PCFW_API int INTERNAL_get_key(window *window, int key, int type);
+	PCFW_API int INTERNAL_get_cursor_position(window *window, int *x, int *y);
+	PCFW_API const char **INTERNAL_get_required_instance_extensions(unsigned int *count);
+	PCFW_API int INTERNAL_get_gamepad_state(int gamepad, gamepad_state *state);
+	PCFW_API const monitor *INTERNAL_get_monitors(window *window, int *count);
+	PCFW_API int INTERNAL_get_window_monitor(window *window);
+	PCFW_API int INTERNAL_set_window_fullscreen(window *window, int monitor, int width, int height, double refresh_rate);
+	PCFW_API int INTERNAL_set_clipboard(window *window, const char *type, const void *data, size_t size);
+	PCFW_API int INTERNAL_request_clipboard(window *window, const char *type, clipboard_callback callback, void *user_data);
+	PCFW_API program_cache *INTERNAL_create_program_cache(window *window, const char *directory);
+	PCFW_API unsigned int INTERNAL_program_cache_load(program_cache *cache, const char *const *sources, int count);
+	PCFW_API int INTERNAL_program_cache_store(program_cache *cache, const char *const *sources, int count, unsigned int program);
+	PCFW_API int INTERNAL_set_gpu_timing(window *window, int enabled);
+	PCFW_API int INTERNAL_begin_gpu_scope(window *window, const char *name);
+	PCFW_API int INTERNAL_end_gpu_scope(window *window);
+	PCFW_API int INTERNAL_get_gpu_frame_time(window *window, double *milliseconds);
+	PCFW_API int INTERNAL_get_gpu_scope_time(window *window, const char *name, double *milliseconds);
+	PCFW_API int INTERNAL_set_max_frames_in_flight(window *window, int frames);
+	PCFW_API int INTERNAL_get_frame_fence_wait(window *window, double *milliseconds);
+	PCFW_API int INTERNAL_set_frame_arena(window *window, size_t block_size, int buffers);
+	PCFW_API void *INTERNAL_frame_alloc(window *window, size_t size, size_t alignment);
+	PCFW_API int INTERNAL_get_frame_arena_high_water(window *window, size_t *bytes);
+
+#ifdef __linux__
+	// Backends of Linux. The X11 one is always built, the Wayland one only with `PCFW_WAYLAND`
+	constexpr int BACKEND_X11 = 0;
+	constexpr int BACKEND_WAYLAND = 1;
+
+	// Wayland functions. `framework_linux.cpp` calls them when the window uses the Wayland backend
+	struct INTERNAL_wayland_window;
+
+	int WAYLAND_create_window(window *window);
+	int WAYLAND_destroy_window(window *window);
+	int WAYLAND_make_context_current(window *window);
+	void WAYLAND_poll_events(window *window);
+	int WAYLAND_get_event_fd(window *window);
+	void WAYLAND_dispatch_pending(window *window);
+	int WAYLAND_prepare_events(window *window);
+	void WAYLAND_check_events(window *window);
+	void WAYLAND_wait_events(window *window, int timeout);
+	void WAYLAND_swap_buffers(window *window);
+	void WAYLAND_set_swap_interval(window *window, int interval);
+	void WAYLAND_set_window_limits(window *window, int minimum_width, int minimum_height, int maximum_width, int maximum_height);
+	void *WAYLAND_get_proc_address(const char *proc);
+	int WAYLAND_get_cursor_position(window *window, int *x, int *y);
+
+	// Empties the eventfd of `request_redraw` after it woke a poll up
+	void INTERNAL_clear_wake_fd(int fd);
+
+	// Opens the first library of a `nullptr` ended list that exists. The first name is the one of the runtime packages
+	void *INTERNAL_open_library(const char *const *names);
+
+	// The backend of the last created window, the one `INTERNAL_get_proc_address` loads from
+	int INTERNAL_get_current_backend();
+
+	// Gamepads of the Linux backend. Their fds are polled with the display connection by `INTERNAL_poll_events`
+
+	// The gamepads and the hotplug watch
+	constexpr int GAMEPAD_FD_MAX = GAMEPAD_MAX + 1;
+
+	// Writes the fds to poll into `fds`. Returns how many were written, none until the gamepads are used
+	int INTERNAL_gamepad_fds(pollfd *fds, int max);
+	// Reads every ready fd without blocking and publishes the new states
+	void INTERNAL_gamepad_process(const pollfd *fds, int count);
+	// Uses an already opened evdev fd as a gamepad, e.g. one end of a pipe in tests. Returns the gamepad or `-1`
+	PCFW_API int INTERNAL_gamepad_attach_fd(int fd, const char *name);
+
+	// Atoms of a window. They are interned together with a single round trip when the window is created
+	enum INTERNAL_atom
+	{
+		ATOM_WM_PROTOCOLS,
+		ATOM_WM_DELETE_WINDOW,
+		ATOM_NET_WM_NAME,
+		ATOM_UTF8_STRING,
+		ATOM_CLIPBOARD,
+		ATOM_TARGETS,
+		ATOM_INCR,
+		ATOM_PCFW_SELECTION,
+		ATOM_NET_WM_STATE,
+		ATOM_NET_WM_STATE_FULLSCREEN,
+		ATOM_NET_WM_STATE_HIDDEN,
+		ATOM_NET_WM_BYPASS_COMPOSITOR,
+		ATOM_NET_WM_SYNC_REQUEST,
+		ATOM_NET_WM_SYNC_REQUEST_COUNTER,
+		ATOM_NET_FRAME_EXTENTS,
+		ATOM_COUNT
+	};
+
+	// Frame limiter of `set_target_frame_rate`, in nanoseconds of `CLOCK_MONOTONIC`
+	struct INTERNAL_frame_limiter
+	{
+		long long _period;
+		// When the next swap may happen, `0` before the first one
+		long long _deadline;
+		// How early the sleep ends, learned from how late `clock_nanosleep` wakes up
+		long long _budget;
+
+		// `set_hidden_frame_rate`, used instead of the others while the window can't be seen
+		long long _hidden_period;
+		long long _hidden_deadline;
+	};
+
+	// A monitor found by XRandR
+	struct INTERNAL_monitor
+	{
+		RROutput _output;
+		RRCrtc _crtc;
+		RRMode _mode;
+		int _x, _y, _width, _height;
+	};
+
+	// OpenGL functions the framework calls itself. Missing ones are `nullptr`
+	struct INTERNAL_gl
+	{
+		const GLubyte *(GLAPIENTRY *_get_string)(GLenum name);
+		void (GLAPIENTRY *_get_integerv)(GLenum name, GLint *data);
+		GLuint (GLAPIENTRY *_create_program)();
+		void (GLAPIENTRY *_delete_program)(GLuint program);
+		void (GLAPIENTRY *_get_programiv)(GLuint program, GLenum name, GLint *parameters);
+		void (GLAPIENTRY *_get_program_binary)(GLuint program, GLsizei size, GLsizei *length, GLenum *format, void *binary);
+		void (GLAPIENTRY *_program_binary)(GLuint program, GLenum format, const void *binary, GLsizei length);
+		void (GLAPIENTRY *_gen_queries)(GLsizei count, GLuint *queries);
+		void (GLAPIENTRY *_delete_queries)(GLsizei count, const GLuint *queries);
+		void (GLAPIENTRY *_query_counter)(GLuint query, GLenum target);
+		void (GLAPIENTRY *_get_query_objectiv)(GLuint query, GLenum name, GLint *parameters);
+		void (GLAPIENTRY *_get_query_objectui64v)(GLuint query, GLenum name, GLuint64 *parameters);
+		void (GLAPIENTRY *_use_program)(GLuint program);
+		void (GLAPIENTRY *_bind_vertex_array)(GLuint vertex_array);
+		void (GLAPIENTRY *_active_texture)(GLenum unit);
+		void (GLAPIENTRY *_bind_texture)(GLenum target, GLuint texture);
+		void (GLAPIENTRY *_uniform1i)(GLint location, GLint value);
+		void (GLAPIENTRY *_uniform1fv)(GLint location, GLsizei count, const GLfloat *values);
+		void (GLAPIENTRY *_uniform2fv)(GLint location, GLsizei count, const GLfloat *values);
+		void (GLAPIENTRY *_uniform3fv)(GLint location, GLsizei count, const GLfloat *values);
+		void (GLAPIENTRY *_uniform4fv)(GLint location, GLsizei count, const GLfloat *values);
+		void (GLAPIENTRY *_uniform_matrix4fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat *values);
+		void (GLAPIENTRY *_viewport)(GLint x, GLint y, GLsizei width, GLsizei height);
+		void (GLAPIENTRY *_draw_arrays)(GLenum mode, GLint first, GLsizei count);
+		void (GLAPIENTRY *_draw_arrays_instanced)(GLenum mode, GLint first, GLsizei count, GLsizei instances);
+		void (GLAPIENTRY *_draw_elements)(GLenum mode, GLsizei count, GLenum type, const void *indices);
+		void (GLAPIENTRY *_draw_elements_instanced)(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instances);
+		GLsync (GLAPIENTRY *_fence_sync)(GLenum condition, GLbitfield flags);
+		GLenum (GLAPIENTRY *_client_wait_sync)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+		void (GLAPIENTRY *_delete_sync)(GLsync sync);
+	};
+
+	// Loads the functions of the current backend once, with a context current
+	const INTERNAL_gl &INTERNAL_load_gl();
+
+	// GPU timing of a window, in `framework_gpu_timer.cpp`. The frame functions are called around `INTERNAL_swap_buffers`
+	struct INTERNAL_gpu_timer;
+
+	void INTERNAL_gpu_timer_end_frame(window *window);
+	void INTERNAL_gpu_timer_begin_frame(window *window);
+	// Frees the timer without GL calls, the queries die with the context
+	void INTERNAL_free_gpu_timer(window *window);
+
+	// Fences of `set_max_frames_in_flight`, in `framework_frame_fences.cpp`. Called after `INTERNAL_swap_buffers`
+	struct INTERNAL_frame_fences;
+
+	void INTERNAL_fence_frame(window *window);
+	// Frees the fences without GL calls, they die with the context
+	void INTERNAL_free_frame_fences(window *window);
+
+	// Replays the command buffers submitted to a window, in `framework_commands.cpp`. Called before `INTERNAL_swap_buffers`
+	void INTERNAL_replay_commands(window *window);
+
+	// A clipboard being sent in chunks with the INCR protocol
+	struct INTERNAL_clipboard_transfer
+	{
+		Window _requestor;
+		Atom _property;
+		Atom _type;
+		std::shared_ptr<const std::vector<unsigned char>> _data;
+		size_t _offset;
+		// The empty chunk that ends the transfer was sent
+		bool _finished;
+		// When the requestor took the last chunk, transfers that stall are dropped
+		long long _time;
+	};
+
+	struct INTERNAL_clipboard
+	{
+		// What the window owns. Transfers keep the old data alive when it's replaced
+		std::shared_ptr<const std::vector<unsigned char>> _data;
+		Atom _type;
+		std::vector<INTERNAL_clipboard_transfer> _transfers;
+
+		// What the window is receiving
+		clipboard_callback _callback;
+		void *_user_data;
+		bool _incremental;
+		// When the request was sent or the last chunk came, requests that stall fail
+		long long _time;
+	};
+#endif
 
 
 	// Implementation of the opaque struct "window"
@@ -49,6 +370,14 @@ namespace PC::Framework
             bool _should_close;
             bool _key_state[256];
             void (*_proc)(const char *proc_name);
+            int _client_api;
+            // The interval asked by `set_swap_interval`. Scheduled windows may use another one
+            int _swap_interval;
+            scheduler *_scheduler;
+            // The `EVENTS_*` asked by `subscribe_events`
+            int _events;
+            // `frame_alloc`
+            INTERNAL_frame_arenas _frame_arenas;
         } config;
 
         struct event
@@ -56,6 +385,12 @@ namespace PC::Framework
             framebuffer_size_callback _framebuffer_size_callback;
             mouse_callback _mouse_callback;
 	    key_callback _key_callback;
+            refresh_callback _refresh_callback;
+            // `needs_redraw`. Other threads set it with `request_redraw`
+            std::atomic<bool> _redraw;
+#ifdef PCFW_COROUTINES
+            INTERNAL_coroutines *_coroutines;
+#endif
         } event;
         
         struct internal
@@ -64,20 +399,108 @@ namespace PC::Framework
             // Xlib stuff
             Display *_display;
             Window _handle;
-            Colormap _colormap;
             int _screen;
             XEvent _event;
             // Visual *_visual;
             XVisualInfo *_visual_info;
             GLXContext _gl_context;
             XSetWindowAttributes _attributes;
-            Atom _wm_delete_window;
+            Atom _atoms[ATOM_COUNT];
+
+            // XCB connection of `_display`, used to send requests without waiting for each reply
+            xcb_connection_t *_connection;
+            // Sequence of the prefetched cursor query, zero if there's none
+            unsigned int _pointer_request;
+            // The frame of `_frame_arenas` the query was sent in. Its reply is stale in any other frame
+            unsigned long long _pointer_frame;
+            bool _pointer_wanted;
+
+            INTERNAL_clipboard _clipboard;
+
+            // XRandR, if the server has it
+            bool _randr;
+            int _randr_event_base;
+
+            // The monitors, queried again only after XRandR notifies a change
+            std::vector<INTERNAL_monitor> _monitors;
+            std::vector<monitor> _monitor_info;
+            bool _monitors_valid;
+
+            INTERNAL_frame_limiter _limiter;
+
+            // What `get_window_visibility` is made of. Mapped by `INTERNAL_create_window`, minimized by `_NET_WM_STATE_HIDDEN`
+            // and obscured by VisibilityNotify
+            bool _mapped;
+            bool _minimized;
+            bool _obscured;
+
+            // Position of the window on the root window, if known
+            int _root_x, _root_y;
+            bool _position_valid;
+
+            // `_NET_WM_SYNC_REQUEST`. The value asked by the window manager is set to the counter after the frame of the new size is swapped
+            XSyncCounter _sync_counter;
+            XSyncValue _sync_value;
+            bool _sync_requested;
+            bool _sync_configured;
+
+            // Fullscreen, the geometry to go back to and the video mode to restore
+            bool _fullscreen;
+            int _windowed_x, _windowed_y, _windowed_width, _windowed_height;
+            RRCrtc _mode_crtc;
+            RRMode _original_mode;
+            // Set when the screen was grown for the mode, `0` otherwise
+            int _original_screen_width, _original_screen_height, _original_screen_mm_width, _original_screen_mm_height;
+
+            // The backend of the window and its Wayland state, if it uses it
+            int _backend;
+            INTERNAL_wayland_window *_wayland;
+
+            // Timestamp queries of `set_gpu_timing`, `nullptr` when it's off
+            INTERNAL_gpu_timer *_gpu_timer;
+
+            // Fences of `set_max_frames_in_flight`, `nullptr` when the frames aren't limited
+            INTERNAL_frame_fences *_frame_fences;
+
+            // Command buffers of `submit_command_buffer`, replayed by `swap_buffers`. Other threads submit under the mutex,
+            // and the buffers being replayed are swapped out of it, so submitting never waits for a replay
+            std::mutex _commands_mutex;
+            std::vector<command_buffer *> _commands;
+            std::vector<command_buffer *> _replaying;
+
+            // An eventfd written by `request_redraw`, polled with the display connection so `wait_events` wakes up
+            int _wake_fd;
+            // `wait_events` or `needs_redraw` was used, so the exposes are selected to set `_redraw`
+            bool _on_demand;
 #elif _WIN64
             // Windows stuff
             // To be added
 #endif
         } internal;
     };
+
+	// Implementation of the opaque struct "program_cache"
+	struct program_cache
+	{
+		std::string _directory;
+		// Hash of `GL_RENDERER` and `GL_VERSION`, binaries of other drivers never match
+		unsigned long long _context_hash;
+	};
+
+	// Implementation of the opaque struct "command_buffer". Packets of a `command_header` and its payload.
+	// The vector is the arena of the buffer: packets are appended and a reset keeps the capacity, so a frame like
+	// the last one allocates nothing. The frame arenas aren't used, a buffer has no window and can be replayed in later frames
+	struct command_buffer
+	{
+		std::vector<unsigned char> _packets;
+	};
+
+	// Implementation of the opaque struct "scheduler"
+	struct scheduler
+	{
+		// The first window is the one that waits the V-Sync
+		std::vector<window *> _windows;
+	};
 } // namespace PCFW
 
 #endif // PCFW_INTERNAL_HPP
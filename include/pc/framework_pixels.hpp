@@ -0,0 +1,79 @@
+// Author: oknauta
+// License: MIT
+// File: framework_pixels.hpp
+// Date: 2026-10-19
+
+// Conversions of pixels moved between OpenGL and memory, e.g. screenshots, window icons and software framebuffers.
+// They use the widest SIMD the CPU has, chosen once at runtime
+
+#ifndef PCFW_PIXELS_HPP
+#define PCFW_PIXELS_HPP
+
+#include "framework.hpp"
+#include <cstddef>
+
+namespace PC::Framework
+{
+    // Kernels of `set_pixel_kernels`
+
+    constexpr int PIXEL_KERNELS_SCALAR = 0;
+    constexpr int PIXEL_KERNELS_SSE2 = 1;
+    constexpr int PIXEL_KERNELS_AVX2 = 2;
+    constexpr int PIXEL_KERNELS_NEON = 3;
+
+    /**
+     * @brief Gets the kernels used by the conversions
+     * @return One of `PIXEL_KERNELS_*`
+     */
+    PCFW_API int get_pixel_kernels();
+
+    /**
+     * @brief Forces some kernels, e.g. to compare them with the scalar ones
+     * @param kernels One of `PIXEL_KERNELS_*`
+     * @return `1` if the CPU doesn't have them
+     */
+    PCFW_API int set_pixel_kernels(int kernels);
+
+    /**
+     * @brief Flips an image upside down in place, like the rows read by `glReadPixels`
+     * @param pixels The first row
+     * @param row_size The bytes of a row that are flipped
+     * @param height The number of rows
+     * @param stride The bytes from a row to the next
+     */
+    PCFW_API void flip_rows(void *pixels, size_t row_size, int height, size_t stride);
+
+    /**
+     * @brief Swaps the red and blue channels, from RGBA8 to BGRA8 or back. `destination` can be `source`
+     * @param destination Where the pixels are written
+     * @param source The pixels
+     * @param count The number of pixels
+     */
+    PCFW_API void swizzle_red_blue(void *destination, const void *source, size_t count);
+
+    /**
+     * @brief Multiplies the colors of RGBA8 pixels by their alpha, rounded. `destination` can be `source`
+     * @param destination Where the pixels are written
+     * @param source The pixels
+     * @param count The number of pixels
+     */
+    PCFW_API void premultiply_alpha(void *destination, const void *source, size_t count);
+
+    /**
+     * @brief Converts 8-bit components to floats from `0.0` to `1.0`
+     * @param destination Where the floats are written
+     * @param source The components
+     * @param count The number of components, not pixels
+     */
+    PCFW_API void unorm8_to_float(float *destination, const unsigned char *source, size_t count);
+
+    /**
+     * @brief Converts floats to 8-bit components, clamped to `0.0` and `1.0` and rounded
+     * @param destination Where the components are written
+     * @param source The floats
+     * @param count The number of components, not pixels
+     */
+    PCFW_API void float_to_unorm8(unsigned char *destination, const float *source, size_t count);
+} // namespace PCFW
+
+#endif // PCFW_PIXELS_HPP
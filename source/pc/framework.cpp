@@ -6,20 +6,53 @@
 #include "pc/framework.hpp"
 #include "pc/framework_internal.hpp"
 #include <pc/log.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
 
 namespace PC::Framework
 {
+	// Hints given by `window_hint`, used by `create_window`
+	static int _hint_client_api = CLIENT_API_OPENGL;
+
+	// The window whose context `make_context_current` made current on this thread
+	static thread_local window *_current_window = nullptr;
+
+	bool INTERNAL_validation_failed(INTERNAL_validation_site &site, const char *message)
+	{
+		if constexpr (VALIDATION_LEVEL == VALIDATION_ASSERT)
+		{
+			// Not `assert`, which `NDEBUG` would strip although the level asks for it
+			PC::Log::error("%s", message);
+			std::abort();
+		}
+		else if constexpr (VALIDATION_LEVEL == VALIDATION_LOG)
+		{
+			unsigned int count = site._count.fetch_add(1, std::memory_order_relaxed) + 1;
+
+			if (count <= VALIDATION_LOG_BURST)
+			{
+				PC::Log::warning("%s", message);
+			}
+			else if ((count & (count - 1)) == 0)
+			{
+				PC::Log::warning("%s (repeated %u times)", message, count);
+			}
+		}
+
+		return false;
+	}
+
 	int set_key_callback(window *window, key_callback callback)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window to set key callback"))
 		{
-			Log::warning("No window to set key callback");
 			return 1;
 		}
 
-		if (!callback)
+		if (!PCFW_VALIDATE(callback, "No key callback to set into the window"))
 		{
-			Log::warning("No key callback to set into the window");
 			return 1;
 		}
 
@@ -33,15 +66,13 @@ namespace PC::Framework
 
 	int set_framebuffer_size_callback(window *window, framebuffer_size_callback callback)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window to set framebuffer size callback"))
 		{
-			PC::Log::warning("No window to set framebuffer size callback");
 			return 1;
 		}
 		
-		if (!callback)
+		if (!PCFW_VALIDATE(callback, "No framebuffer size callback to set into the window"))
 		{
-			PC::Log::warning("No framebuffer size callback to set into the window");
 			return 1;
 		}
 
@@ -53,23 +84,31 @@ namespace PC::Framework
 		return 0;
 	};
 
+	int set_window_refresh_callback(window *window, refresh_callback callback)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set the refresh callback") || !PCFW_VALIDATE(callback, "No refresh callback to set into the window"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_set_window_refresh_callback(window, callback);
+	}
+
 	int set_mouse_callback(window *window, mouse_callback callback)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window to set mouse callback"))
 		{
-	    		PC::Log::warning("No window to set mouse callback");
-	    		return 1;
+			return 1;
 		}
 
-		if (!callback)
+		if (!PCFW_VALIDATE(callback, "No mouse callback setted"))
 		{
-			PC::Log::warning("No mouse callback setted");
-	    		return 1;
+			return 1;
 		}
 
 		if (INTERNAL_set_mouse_callback(window, callback) != 0)
 		{
-	    		return 1;
+			return 1;
 		}
 
 		return 0;
@@ -82,9 +121,8 @@ namespace PC::Framework
 
 	int set_window_limits(window *window, int minimum_width, int minimum_height, int maximum_width, int maximum_height)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window to set limits"))
 		{
-			PC::Log::warning("No window to set limits");
 			return 1;
 		}
 
@@ -95,9 +133,8 @@ namespace PC::Framework
 
 	int make_context_current(window *window)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window to make context current"))
 		{
-			PC::Log::warning("No window to make context current");
 			return 1;
 		}
 
@@ -106,35 +143,452 @@ namespace PC::Framework
 			return 1;
 		}
 
+		_current_window = window;
 		return 0;
 	}
 
 	void swap_buffers(window *window)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window to swap buffer"))
 		{
-			PC::Log::warning("No window to swap buffer");
 			return;
 		}
 
+		// Replayed first, so the GPU works on them during the wait
+		INTERNAL_replay_commands(window);
+		INTERNAL_wait_frame(window);
+		INTERNAL_gpu_timer_end_frame(window);
 		INTERNAL_swap_buffers(window);
+		INTERNAL_fence_frame(window);
+		INTERNAL_gpu_timer_begin_frame(window);
+
+		// The frame arenas reset the next time each thread allocates
+		window->config._frame_arenas._frame.fetch_add(1, std::memory_order_release);
+
+#ifdef PCFW_COROUTINES
+		INTERNAL_resume_timers(window);
+		INTERNAL_resume_frame_waiters(window);
+#endif
+	}
+
+	int subscribe_events(window *window, int events)
+	{
+		if (!PCFW_VALIDATE(window, "No window to subscribe events"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_subscribe_events(window, events);
 	}
 
 	void set_swap_interval(window *window, int interval)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window to set swap interval"))
 		{
-			PC::Log::warning("No window to set swap interval");
 			return;
 		}
+
+		window->config._swap_interval = interval;
+
+		// Scheduled windows that aren't the first keep swapping with interval 0
+		if (window->config._scheduler && window->config._scheduler->_windows.front() != window)
+		{
+			return;
+		}
+
 		INTERNAL_set_swap_interval(window, interval);
 	}
 
+	void set_target_frame_rate(window *window, double frame_rate)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set the target frame rate") || !PCFW_VALIDATE(frame_rate >= 0.0, "The target frame rate can't be negative"))
+		{
+			return;
+		}
+
+		INTERNAL_set_target_frame_rate(window, frame_rate);
+	}
+
+	int get_window_visibility(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the visibility"))
+		{
+			return VISIBILITY_VISIBLE;
+		}
+
+		return INTERNAL_get_window_visibility(window);
+	}
+
+	void set_hidden_frame_rate(window *window, double frame_rate)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set the hidden frame rate") || !PCFW_VALIDATE(frame_rate >= 0.0, "The hidden frame rate can't be negative"))
+		{
+			return;
+		}
+
+		INTERNAL_set_hidden_frame_rate(window, frame_rate);
+	}
+
+	const monitor *get_monitors(window *window, int *count)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the monitors") || !PCFW_VALIDATE(count, "No count to get the monitors"))
+		{
+			return nullptr;
+		}
+
+		return INTERNAL_get_monitors(window, count);
+	}
+
+	int get_window_monitor(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the monitor"))
+		{
+			return MONITOR_NONE;
+		}
+
+		return INTERNAL_get_window_monitor(window);
+	}
+
+	int set_window_fullscreen(window *window, int monitor)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set fullscreen"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_set_window_fullscreen(window, monitor, 0, 0, 0.0);
+	}
+
+	int set_window_fullscreen_mode(window *window, int monitor, int width, int height, double refresh_rate)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set fullscreen"))
+		{
+			return 1;
+		}
+
+		if (!PCFW_VALIDATE(monitor >= 0 && width > 0 && height > 0, "No monitor or size to set the video mode"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_set_window_fullscreen(window, monitor, width, height, refresh_rate);
+	}
+
+	int set_clipboard(window *window, const char *type, const void *data, size_t size)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set the clipboard"))
+		{
+			return 1;
+		}
+
+		if (!PCFW_VALIDATE(data || size == 0, "No data to set the clipboard"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_set_clipboard(window, type, data, size);
+	}
+
+	int request_clipboard(window *window, const char *type, clipboard_callback callback, void *user_data)
+	{
+		if (!PCFW_VALIDATE(window, "No window to request the clipboard"))
+		{
+			return 1;
+		}
+
+		if (!PCFW_VALIDATE(callback, "No callback to receive the clipboard"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_request_clipboard(window, type, callback, user_data);
+	}
+
+	int get_gamepad_state(int gamepad, gamepad_state *state)
+	{
+		if (!PCFW_VALIDATE(gamepad >= 0 && gamepad < GAMEPAD_MAX, "No gamepad with that number"))
+		{
+			return 1;
+		}
+
+		if (!PCFW_VALIDATE(state, "No state to get the gamepad"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_get_gamepad_state(gamepad, state);
+	}
+
+	scheduler *create_scheduler()
+	{
+		return new scheduler{};
+	}
+
+	int destroy_scheduler(scheduler *scheduler)
+	{
+		if (!PCFW_VALIDATE(scheduler, "No scheduler to destroy"))
+		{
+			return 1;
+		}
+
+		while (!scheduler->_windows.empty())
+		{
+			scheduler_remove_window(scheduler, scheduler->_windows.back());
+		}
+
+		delete scheduler;
+		return 0;
+	}
+
+	int scheduler_add_window(scheduler *scheduler, window *window)
+	{
+		if (!PCFW_VALIDATE(scheduler, "No scheduler to add the window") || !PCFW_VALIDATE(window, "No window to add into the scheduler"))
+		{
+			return 1;
+		}
+
+		if (window->config._scheduler)
+		{
+			PC::Log::warning("The window is already in a scheduler");
+			return 1;
+		}
+
+		window->config._scheduler = scheduler;
+		scheduler->_windows.push_back(window);
+
+		// Only the first window blocks on the V-Sync, the others present right after it
+		if (scheduler->_windows.size() > 1)
+		{
+			INTERNAL_set_swap_interval(window, 0);
+		}
+
+		return 0;
+	}
+
+	int scheduler_remove_window(scheduler *scheduler, window *window)
+	{
+		if (!PCFW_VALIDATE(scheduler, "No scheduler to remove the window") || !PCFW_VALIDATE(window, "No window to remove from the scheduler"))
+		{
+			return 1;
+		}
+
+		std::vector<struct window *>::iterator _position = std::find(scheduler->_windows.begin(), scheduler->_windows.end(), window);
+		if (_position == scheduler->_windows.end())
+		{
+			PC::Log::warning("The window isn't in the scheduler");
+			return 1;
+		}
+
+		bool _first = _position == scheduler->_windows.begin();
+		scheduler->_windows.erase(_position);
+
+		window->config._scheduler = nullptr;
+		INTERNAL_set_swap_interval(window, window->config._swap_interval);
+
+		// The next window starts pacing the others
+		if (_first && !scheduler->_windows.empty())
+		{
+			INTERNAL_set_swap_interval(scheduler->_windows.front(), scheduler->_windows.front()->config._swap_interval);
+		}
+
+		return 0;
+	}
+
+	void scheduler_swap_buffers(scheduler *scheduler)
+	{
+		if (!PCFW_VALIDATE(scheduler, "No scheduler to swap buffers"))
+		{
+			return;
+		}
+
+		window *_previous = _current_window;
+
+		// The first swap waits the V-Sync, the others don't wait anything. The replays, fences and queries of each swap
+		// go to the context of its window
+		for (window *_window : scheduler->_windows)
+		{
+			if (_window->config._client_api == CLIENT_API_OPENGL && _window != _current_window)
+			{
+				make_context_current(_window);
+			}
+
+			swap_buffers(_window);
+		}
+
+		if (_previous && _previous != _current_window)
+		{
+			make_context_current(_previous);
+		}
+	}
+
+	int set_gpu_timing(window *window, int enabled)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set the GPU timing"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_set_gpu_timing(window, enabled);
+	}
+
+	int begin_gpu_scope(window *window, const char *name)
+	{
+		if (!PCFW_VALIDATE(window, "No window to begin the GPU scope") || !PCFW_VALIDATE(name, "No name to begin the GPU scope"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_begin_gpu_scope(window, name);
+	}
+
+	int end_gpu_scope(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to end the GPU scope"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_end_gpu_scope(window);
+	}
+
+	int get_gpu_frame_time(window *window, double *milliseconds)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the GPU frame time") || !PCFW_VALIDATE(milliseconds, "No variable to get the GPU frame time"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_get_gpu_frame_time(window, milliseconds);
+	}
+
+	int get_gpu_scope_time(window *window, const char *name, double *milliseconds)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the GPU scope time") || !PCFW_VALIDATE(name && milliseconds, "No name or variable to get the GPU scope time"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_get_gpu_scope_time(window, name, milliseconds);
+	}
+
+	int set_max_frames_in_flight(window *window, int frames)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set the frames in flight") ||
+			!PCFW_VALIDATE(frames >= 0 && frames <= FRAMES_IN_FLIGHT_MAX, "The frames in flight are from 0 to FRAMES_IN_FLIGHT_MAX"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_set_max_frames_in_flight(window, frames);
+	}
+
+	int get_frame_fence_wait(window *window, double *milliseconds)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the fence wait") || !PCFW_VALIDATE(milliseconds, "No variable to get the fence wait"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_get_frame_fence_wait(window, milliseconds);
+	}
+
+	int set_frame_arena(window *window, size_t block_size, int buffers)
+	{
+		if (!PCFW_VALIDATE(window, "No window to set the frame arena") || !PCFW_VALIDATE(block_size > 0, "The blocks of the frame arena can't be empty") ||
+			!PCFW_VALIDATE(buffers == 1 || buffers == 2, "The frame arena has 1 or 2 buffers"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_set_frame_arena(window, block_size, buffers);
+	}
+
+	void *frame_alloc(window *window, size_t size, size_t alignment)
+	{
+		if (!PCFW_VALIDATE(window, "No window to allocate from") || !PCFW_VALIDATE(alignment > 0 && (alignment & (alignment - 1)) == 0, "The alignment must be a power of two"))
+		{
+			return nullptr;
+		}
+
+		return INTERNAL_frame_alloc(window, size, alignment);
+	}
+
+	int get_frame_arena_high_water(window *window, size_t *bytes)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the high water mark") || !PCFW_VALIDATE(bytes, "No variable to get the high water mark"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_get_frame_arena_high_water(window, bytes);
+	}
+
+	void set_tracing(int enabled)
+	{
+		INTERNAL_tracing.store(enabled != 0, std::memory_order_relaxed);
+	}
+
+	int write_trace(const char *path)
+	{
+		if (!PCFW_VALIDATE(path, "No path to write the trace"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_write_trace(path);
+	}
+
+	program_cache *create_program_cache(window *window, const char *directory)
+	{
+		if (!PCFW_VALIDATE(window, "No window to create the program cache") || !PCFW_VALIDATE(directory, "No directory to create the program cache"))
+		{
+			return nullptr;
+		}
+
+		// The binaries are keyed by the driver of the current context, so it must be the one of the window
+		if (_current_window != window && make_context_current(window))
+		{
+			return nullptr;
+		}
+
+		return INTERNAL_create_program_cache(window, directory);
+	}
+
+	int destroy_program_cache(program_cache *cache)
+	{
+		if (!PCFW_VALIDATE(cache, "No program cache to destroy"))
+		{
+			return 1;
+		}
+
+		delete cache;
+		return 0;
+	}
+
+	unsigned int program_cache_load(program_cache *cache, const char *const *sources, int count)
+	{
+		if (!PCFW_VALIDATE(cache, "No program cache to load from") || !PCFW_VALIDATE(sources && count > 0, "No shader sources to load the program"))
+		{
+			return 0;
+		}
+
+		return INTERNAL_program_cache_load(cache, sources, count);
+	}
+
+	int program_cache_store(program_cache *cache, const char *const *sources, int count, unsigned int program)
+	{
+		if (!PCFW_VALIDATE(cache, "No program cache to store into") || !PCFW_VALIDATE(sources && count > 0, "No shader sources to store the program") || !PCFW_VALIDATE(program, "No program to store"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_program_cache_store(cache, sources, count, program);
+	}
+
 	int window_should_close(window *window)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window shall close"))
 		{
-			PC::Log::warning("No window shall close");
 			return true;
 		}
 		return INTERNAL_window_should_close(window);
@@ -142,17 +596,198 @@ namespace PC::Framework
 
 	void poll_events(window *window)
 	{
-		if (!window)
+		if (!PCFW_VALIDATE(window, "No window to poll events"))
 		{
-			PC::Log::warning("No window to poll events");
 			return;
 		}
 		INTERNAL_poll_events(window);
+
+#ifdef PCFW_COROUTINES
+		INTERNAL_resume_timers(window);
+#endif
+	}
+
+	void wait_events(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to wait for events"))
+		{
+			return;
+		}
+
+		int _timeout = -1;
+
+#ifdef PCFW_COROUTINES
+		// Coroutines sleeping in `wait_timeout` wake the wait up too
+		_timeout = INTERNAL_clamp_to_timers(window, _timeout);
+#endif
+
+		INTERNAL_wait_events(window, _timeout);
+
+#ifdef PCFW_COROUTINES
+		INTERNAL_resume_timers(window);
+#endif
+	}
+
+	void wait_events_timeout(window *window, double timeout)
+	{
+		if (!PCFW_VALIDATE(window, "No window to wait for events") || !PCFW_VALIDATE(timeout >= 0.0, "The timeout to wait for events is negative"))
+		{
+			return;
+		}
+
+		// Rounded up, so an animation doesn't wake up just before its frame
+		double _milliseconds = std::ceil(timeout * 1000.0);
+		int _timeout = _milliseconds < INT_MAX ? static_cast<int>(_milliseconds) : INT_MAX;
+
+#ifdef PCFW_COROUTINES
+		_timeout = INTERNAL_clamp_to_timers(window, _timeout);
+#endif
+
+		INTERNAL_wait_events(window, _timeout);
+
+#ifdef PCFW_COROUTINES
+		INTERNAL_resume_timers(window);
+#endif
+	}
+
+	void request_redraw(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to request a redraw"))
+		{
+			return;
+		}
+
+		INTERNAL_request_redraw(window);
+	}
+
+	int needs_redraw(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to check for a redraw"))
+		{
+			return 0;
+		}
+
+		return INTERNAL_needs_redraw(window);
+	}
+
+	int get_event_fd(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the event fd"))
+		{
+			return -1;
+		}
+
+		return INTERNAL_get_event_fd(window);
+	}
+
+	int get_event_fds(window *window, int *fds, int max)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the event fds") || !PCFW_VALIDATE(fds, "No array to receive the event fds"))
+		{
+			return 0;
+		}
+
+		return INTERNAL_get_event_fds(window, fds, max);
+	}
+
+	void dispatch_pending(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to dispatch the events"))
+		{
+			return;
+		}
+
+		INTERNAL_dispatch_pending(window);
+
+#ifdef PCFW_COROUTINES
+		INTERNAL_resume_timers(window);
+#endif
+	}
+
+	int prepare_events(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to prepare the events"))
+		{
+			return 0;
+		}
+
+		return INTERNAL_prepare_events(window);
+	}
+
+	void check_events(window *window)
+	{
+		if (!PCFW_VALIDATE(window, "No window to check the events"))
+		{
+			return;
+		}
+
+		INTERNAL_check_events(window);
+
+#ifdef PCFW_COROUTINES
+		INTERNAL_resume_timers(window);
+#endif
+	}
+
+	void INTERNAL_post_event(window *window, [[maybe_unused]] const event &event)
+	{
+		// The posted events are input, resizes and closes, a loop drawing on demand has to see them
+		window->event._redraw = true;
+
+#ifdef PCFW_COROUTINES
+		INTERNAL_resume_event_waiters(window, event);
+#endif
+	}
+
+	int get_key(window *window, int key, int type)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the key") || !PCFW_VALIDATE(key >= 0 && key < 256, "The key isn't a keycode"))
+		{
+			return 0;
+		}
+
+		return INTERNAL_get_key(window, key, type);
+	}
+
+	int get_cursor_position(window *window, int *x, int *y)
+	{
+		if (!PCFW_VALIDATE(window, "No window to get the cursor position"))
+		{
+			return 1;
+		}
+
+		return INTERNAL_get_cursor_position(window, x, y);
+	}
+
+	void window_hint(int hint, int value)
+	{
+		switch (hint)
+		{
+		case HINT_CLIENT_API:
+			if (!PCFW_VALIDATE(value == CLIENT_API_OPENGL || value == CLIENT_API_NONE, "Unknown client API hint"))
+			{
+				return;
+			}
+			_hint_client_api = value;
+			break;
+		default:
+			PCFW_VALIDATE(false, "Unknown window hint");
+			break;
+		}
+	}
+
+	const char **get_required_instance_extensions(unsigned int *count)
+	{
+		if (!PCFW_VALIDATE(count, "No count to get the required instance extensions"))
+		{
+			return nullptr;
+		}
+
+		return INTERNAL_get_required_instance_extensions(count);
 	}
 
 	window *create_window(int width, int height, const char *title)
 	{
-		window *_window = new window;
+		window *_window = new window{};
 		if (!_window)
 		{
 			PC::Log::error("Failed to allocate memory to the window");
@@ -163,9 +798,16 @@ namespace PC::Framework
 		_window->config._title = title;
 		_window->config._width = width;
 		_window->config._height = height;
+		_window->config._client_api = _hint_client_api;
+		// Most drivers start with V-Sync
+		_window->config._swap_interval = 1;
+		_window->config._events = EVENTS_KEY;
+		INTERNAL_init_frame_arenas(_window);
 
+		// What was created before the failure is destroyed too
 		if (INTERNAL_create_window(_window))
 		{
+		    INTERNAL_destroy_window(_window);
 		    delete _window;
 		    return nullptr;
 		}
@@ -175,12 +817,29 @@ namespace PC::Framework
 
 	int destroy_window(window *window)
 	{
-		if (window == nullptr)
+		if (!PCFW_VALIDATE(window != nullptr, "No window to destroy"))
 		{
-			PC::Log::warning("No window to destroy");
 			return 1;
 		}
+		if (window->config._scheduler)
+		{
+			scheduler_remove_window(window->config._scheduler, window);
+		}
+
+#ifdef PCFW_COROUTINES
+		INTERNAL_destroy_coroutines(window);
+#endif
+
+		INTERNAL_free_gpu_timer(window);
+		INTERNAL_free_frame_fences(window);
 		INTERNAL_destroy_window(window);
+
+		if (_current_window == window)
+		{
+			_current_window = nullptr;
+		}
+
+		INTERNAL_free_frame_arenas(window);
 		delete window;
 		return 0;
 	}
@@ -0,0 +1,426 @@
+// Author: oknauta
+// License: MIT
+// File: framework_commands.cpp
+// Date: 2026-10-19
+
+#ifdef __linux__
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <cstdint>
+#include <cstring>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    enum command_type : uint32_t
+    {
+        COMMAND_USE_PROGRAM,
+        COMMAND_BIND_VERTEX_ARRAY,
+        COMMAND_BIND_TEXTURE,
+        COMMAND_UNIFORM_INT,
+        COMMAND_UNIFORM_FLOAT,
+        COMMAND_UNIFORM_MATRIX,
+        COMMAND_VIEWPORT,
+        COMMAND_DRAW_ARRAYS,
+        COMMAND_DRAW_ELEMENTS,
+        COMMAND_CALLBACK
+    };
+
+    struct command_header
+    {
+        uint32_t _type;
+        // Of the payload, the next packet starts after it
+        uint32_t _size;
+    };
+
+    // Payloads. The ones of one value are stored as that value
+
+    struct bind_texture_command
+    {
+        GLuint _unit;
+        GLenum _target;
+        GLuint _texture;
+    };
+
+    struct uniform_int_command
+    {
+        GLint _location;
+        GLint _value;
+    };
+
+    struct uniform_float_command
+    {
+        GLint _location;
+        GLint _components;
+        GLfloat _values[4];
+    };
+
+    struct uniform_matrix_command
+    {
+        GLint _location;
+        GLfloat _values[16];
+    };
+
+    struct viewport_command
+    {
+        GLint _x, _y;
+        GLsizei _width, _height;
+    };
+
+    struct draw_arrays_command
+    {
+        GLenum _mode;
+        GLint _first;
+        GLsizei _count;
+        GLsizei _instances;
+    };
+
+    struct draw_elements_command
+    {
+        GLenum _mode;
+        GLsizei _count;
+        GLenum _type;
+        GLsizei _instances;
+        size_t _offset;
+    };
+
+    struct callback_command
+    {
+        void (*_callback)(void *user_data);
+        void *_user_data;
+    };
+
+    // The packets are read with `memcpy`, so the payloads need no alignment and nothing pads them
+    template <typename payload>
+    static int record(command_buffer *buffer, command_type type, const payload &data)
+    {
+        command_header _header = {type, sizeof(payload)};
+
+        std::vector<unsigned char> &_packets = buffer->_packets;
+        size_t _offset = _packets.size();
+        _packets.resize(_offset + sizeof(command_header) + sizeof(payload));
+
+        memcpy(_packets.data() + _offset, &_header, sizeof(command_header));
+        memcpy(_packets.data() + _offset + sizeof(command_header), &data, sizeof(payload));
+
+        return 0;
+    }
+
+    template <typename payload>
+    static payload read_payload(const unsigned char *data)
+    {
+        payload _payload;
+        memcpy(&_payload, data, sizeof(payload));
+        return _payload;
+    }
+
+    static bool has_commands(const INTERNAL_gl &gl)
+    {
+        return gl._use_program && gl._bind_vertex_array && gl._active_texture && gl._bind_texture && gl._uniform1i && gl._uniform1fv && gl._uniform2fv && gl._uniform3fv && gl._uniform4fv &&
+               gl._uniform_matrix4fv && gl._viewport && gl._draw_arrays && gl._draw_arrays_instanced && gl._draw_elements && gl._draw_elements_instanced;
+    }
+
+    static void replay(const INTERNAL_gl &gl, const command_buffer *buffer)
+    {
+        const unsigned char *_packet = buffer->_packets.data();
+        const unsigned char *_end = _packet + buffer->_packets.size();
+
+        while (_packet < _end)
+        {
+            command_header _header = read_payload<command_header>(_packet);
+            const unsigned char *_data = _packet + sizeof(command_header);
+            _packet = _data + _header._size;
+
+            switch (_header._type)
+            {
+            case COMMAND_USE_PROGRAM:
+                gl._use_program(read_payload<GLuint>(_data));
+                break;
+            case COMMAND_BIND_VERTEX_ARRAY:
+                gl._bind_vertex_array(read_payload<GLuint>(_data));
+                break;
+            case COMMAND_BIND_TEXTURE:
+            {
+                bind_texture_command _command = read_payload<bind_texture_command>(_data);
+                gl._active_texture(GL_TEXTURE0 + _command._unit);
+                gl._bind_texture(_command._target, _command._texture);
+                break;
+            }
+            case COMMAND_UNIFORM_INT:
+            {
+                uniform_int_command _command = read_payload<uniform_int_command>(_data);
+                gl._uniform1i(_command._location, _command._value);
+                break;
+            }
+            case COMMAND_UNIFORM_FLOAT:
+            {
+                uniform_float_command _command = read_payload<uniform_float_command>(_data);
+                switch (_command._components)
+                {
+                case 1:
+                    gl._uniform1fv(_command._location, 1, _command._values);
+                    break;
+                case 2:
+                    gl._uniform2fv(_command._location, 1, _command._values);
+                    break;
+                case 3:
+                    gl._uniform3fv(_command._location, 1, _command._values);
+                    break;
+                default:
+                    gl._uniform4fv(_command._location, 1, _command._values);
+                    break;
+                }
+                break;
+            }
+            case COMMAND_UNIFORM_MATRIX:
+            {
+                uniform_matrix_command _command = read_payload<uniform_matrix_command>(_data);
+                gl._uniform_matrix4fv(_command._location, 1, GL_FALSE, _command._values);
+                break;
+            }
+            case COMMAND_VIEWPORT:
+            {
+                viewport_command _command = read_payload<viewport_command>(_data);
+                gl._viewport(_command._x, _command._y, _command._width, _command._height);
+                break;
+            }
+            case COMMAND_DRAW_ARRAYS:
+            {
+                draw_arrays_command _command = read_payload<draw_arrays_command>(_data);
+                if (_command._instances == 1)
+                {
+                    gl._draw_arrays(_command._mode, _command._first, _command._count);
+                }
+                else
+                {
+                    gl._draw_arrays_instanced(_command._mode, _command._first, _command._count, _command._instances);
+                }
+                break;
+            }
+            case COMMAND_DRAW_ELEMENTS:
+            {
+                draw_elements_command _command = read_payload<draw_elements_command>(_data);
+                const void *_indices = reinterpret_cast<const void *>(_command._offset);
+                if (_command._instances == 1)
+                {
+                    gl._draw_elements(_command._mode, _command._count, _command._type, _indices);
+                }
+                else
+                {
+                    gl._draw_elements_instanced(_command._mode, _command._count, _command._type, _indices, _command._instances);
+                }
+                break;
+            }
+            case COMMAND_CALLBACK:
+            {
+                callback_command _command = read_payload<callback_command>(_data);
+                _command._callback(_command._user_data);
+                break;
+            }
+            }
+        }
+    }
+
+    void INTERNAL_replay_commands(window *window)
+    {
+        std::vector<command_buffer *> &_replaying = window->internal._replaying;
+
+        {
+            std::lock_guard<std::mutex> _lock(window->internal._commands_mutex);
+            if (window->internal._commands.empty())
+            {
+                return;
+            }
+
+            // The empty vector goes back to the submitters with the capacity of the last replay
+            _replaying.swap(window->internal._commands);
+        }
+
+        PCFW_TRACE_SCOPE("replay_commands");
+
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+        if (!has_commands(_gl))
+        {
+            Log::error("PCFW Internal: The context can't replay command buffers");
+        }
+        else
+        {
+            for (const command_buffer *_buffer : _replaying)
+            {
+                replay(_gl, _buffer);
+            }
+        }
+
+        _replaying.clear();
+    }
+
+    command_buffer *create_command_buffer()
+    {
+        return new command_buffer{};
+    }
+
+    int destroy_command_buffer(command_buffer *buffer)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to destroy"))
+        {
+            return 1;
+        }
+
+        delete buffer;
+        return 0;
+    }
+
+    int reset_command_buffer(command_buffer *buffer)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to reset"))
+        {
+            return 1;
+        }
+
+        buffer->_packets.clear();
+        return 0;
+    }
+
+    int command_use_program(command_buffer *buffer, unsigned int program)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into"))
+        {
+            return 1;
+        }
+
+        return record(buffer, COMMAND_USE_PROGRAM, static_cast<GLuint>(program));
+    }
+
+    int command_bind_vertex_array(command_buffer *buffer, unsigned int vertex_array)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into"))
+        {
+            return 1;
+        }
+
+        return record(buffer, COMMAND_BIND_VERTEX_ARRAY, static_cast<GLuint>(vertex_array));
+    }
+
+    int command_bind_texture(command_buffer *buffer, unsigned int unit, unsigned int target, unsigned int texture)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into"))
+        {
+            return 1;
+        }
+
+        return record(buffer, COMMAND_BIND_TEXTURE, bind_texture_command{unit, target, texture});
+    }
+
+    int command_uniform_int(command_buffer *buffer, int location, int value)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into"))
+        {
+            return 1;
+        }
+
+        return record(buffer, COMMAND_UNIFORM_INT, uniform_int_command{location, value});
+    }
+
+    int command_uniform_float(command_buffer *buffer, int location, int components, const float *values)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into") || !PCFW_VALIDATE(values, "No values to record the uniform") ||
+            !PCFW_VALIDATE(components >= 1 && components <= 4, "Uniforms have from 1 to 4 components"))
+        {
+            return 1;
+        }
+
+        uniform_float_command _command = {location, components, {}};
+        memcpy(_command._values, values, components * sizeof(float));
+
+        return record(buffer, COMMAND_UNIFORM_FLOAT, _command);
+    }
+
+    int command_uniform_matrix(command_buffer *buffer, int location, const float *matrix)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into") || !PCFW_VALIDATE(matrix, "No matrix to record the uniform"))
+        {
+            return 1;
+        }
+
+        uniform_matrix_command _command;
+        _command._location = location;
+        memcpy(_command._values, matrix, sizeof(_command._values));
+
+        return record(buffer, COMMAND_UNIFORM_MATRIX, _command);
+    }
+
+    int command_viewport(command_buffer *buffer, int x, int y, int width, int height)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into"))
+        {
+            return 1;
+        }
+
+        return record(buffer, COMMAND_VIEWPORT, viewport_command{x, y, width, height});
+    }
+
+    int command_draw_arrays(command_buffer *buffer, unsigned int mode, int first, int count, int instances)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into") || !PCFW_VALIDATE(instances >= 1, "A draw needs at least one instance"))
+        {
+            return 1;
+        }
+
+        return record(buffer, COMMAND_DRAW_ARRAYS, draw_arrays_command{mode, first, count, instances});
+    }
+
+    int command_draw_elements(command_buffer *buffer, unsigned int mode, int count, unsigned int type, size_t offset, int instances)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into") || !PCFW_VALIDATE(instances >= 1, "A draw needs at least one instance"))
+        {
+            return 1;
+        }
+
+        return record(buffer, COMMAND_DRAW_ELEMENTS, draw_elements_command{mode, count, type, instances, offset});
+    }
+
+    int command_callback(command_buffer *buffer, void (*callback)(void *user_data), void *user_data)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to record into") || !PCFW_VALIDATE(callback, "No callback to record"))
+        {
+            return 1;
+        }
+
+        return record(buffer, COMMAND_CALLBACK, callback_command{callback, user_data});
+    }
+
+    int submit_command_buffer(window *window, command_buffer *buffer)
+    {
+        if (!PCFW_VALIDATE(window, "No window to submit the command buffer") || !PCFW_VALIDATE(buffer, "No command buffer to submit"))
+        {
+            return 1;
+        }
+
+        std::lock_guard<std::mutex> _lock(window->internal._commands_mutex);
+        window->internal._commands.push_back(buffer);
+
+        return 0;
+    }
+
+    int execute_command_buffer(command_buffer *buffer)
+    {
+        if (!PCFW_VALIDATE(buffer, "No command buffer to execute"))
+        {
+            return 1;
+        }
+
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+        if (!has_commands(_gl))
+        {
+            Log::error("PCFW Internal: The context can't replay command buffers");
+            return 1;
+        }
+
+        replay(_gl, buffer);
+        return 0;
+    }
+} // namespace PCFW
+
+#endif
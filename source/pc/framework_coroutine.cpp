@@ -0,0 +1,266 @@
+// Author: oknauta
+// License: MIT
+// File: framework_coroutine.cpp
+// Date: 2026-10-19
+
+#include "pc/framework_coroutine.hpp"
+#include "pc/framework_internal.hpp"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <exception>
+#include <new>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    // Frames are rounded up to granules and kept in a free list per size. Bigger ones aren't pooled
+    constexpr std::size_t COROUTINE_GRANULE = 64;
+    constexpr std::size_t COROUTINE_CLASSES = 32;
+
+    struct free_frame
+    {
+        free_frame *_next;
+    };
+
+    // Per thread, so no lock is needed. A frame freed by another thread just joins that thread's pool
+    static thread_local free_frame *_free_frames[COROUTINE_CLASSES + 1];
+
+    struct event_waiter
+    {
+        std::coroutine_handle<> _handle;
+        event_awaiter *_awaiter;
+    };
+
+    struct timer
+    {
+        long long _deadline;
+        std::coroutine_handle<> _handle;
+    };
+
+    // The vectors keep their capacity, so after the first frames nothing is allocated to resume
+    struct INTERNAL_coroutines
+    {
+        std::vector<std::coroutine_handle<>> _frame_waiters;
+        std::vector<std::coroutine_handle<>> _resuming;
+        std::vector<event_waiter> _event_waiters;
+        std::vector<event_waiter> _event_resuming;
+        // A heap, the nearest deadline first
+        std::vector<timer> _timers;
+    };
+
+    static bool later(const timer &a, const timer &b)
+    {
+        return a._deadline > b._deadline;
+    }
+
+    static long long now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static INTERNAL_coroutines &coroutines(window *window)
+    {
+        if (!window->event._coroutines)
+        {
+            window->event._coroutines = new INTERNAL_coroutines{};
+        }
+
+        return *window->event._coroutines;
+    }
+
+    void *task::promise_type::operator new(std::size_t size)
+    {
+        std::size_t _class = (size + COROUTINE_GRANULE - 1) / COROUTINE_GRANULE;
+        if (_class > COROUTINE_CLASSES)
+        {
+            return ::operator new(size);
+        }
+
+        if (free_frame *_frame = _free_frames[_class])
+        {
+            _free_frames[_class] = _frame->_next;
+            return _frame;
+        }
+
+        return ::operator new(_class * COROUTINE_GRANULE);
+    }
+
+    void task::promise_type::operator delete(void *pointer, std::size_t size)
+    {
+        std::size_t _class = (size + COROUTINE_GRANULE - 1) / COROUTINE_GRANULE;
+        if (_class > COROUTINE_CLASSES)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+
+        free_frame *_frame = static_cast<free_frame *>(pointer);
+        _frame->_next = _free_frames[_class];
+        _free_frames[_class] = _frame;
+    }
+
+    void task::promise_type::unhandled_exception() noexcept
+    {
+        Log::error("PCFW Internal: A coroutine threw an exception");
+        std::terminate();
+    }
+
+    void frame_awaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        coroutines(_window)._frame_waiters.push_back(handle);
+    }
+
+    // The category of `subscribe_events` each event needs. Resizes and closes are always received
+    struct event_category
+    {
+        int _event;
+        int _events;
+    };
+
+    static constexpr event_category EVENT_CATEGORIES[] = {
+        {EVENT_KEY, EVENTS_KEY},
+        {EVENT_MOUSE_BUTTON, EVENTS_MOUSE_BUTTON},
+        {EVENT_MOUSE_MOTION, EVENTS_MOUSE_MOTION},
+        {EVENT_ENTER_LEAVE, EVENTS_ENTER_LEAVE},
+        {EVENT_FOCUS, EVENTS_FOCUS},
+    };
+
+    void event_awaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        int _events = _window->config._events;
+        for (const event_category &_category : EVENT_CATEGORIES)
+        {
+            if (_filter & _category._event)
+            {
+                _events |= _category._events;
+            }
+        }
+
+        if (_events != _window->config._events)
+        {
+            INTERNAL_subscribe_events(_window, _events);
+        }
+
+        coroutines(_window)._event_waiters.push_back({handle, this});
+    }
+
+    void timeout_awaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        std::vector<timer> &_timers = coroutines(_window)._timers;
+
+        _timers.push_back({now() + static_cast<long long>(_seconds * 1e9), handle});
+        std::push_heap(_timers.begin(), _timers.end(), later);
+    }
+
+    void INTERNAL_resume_frame_waiters(window *window)
+    {
+        if (!window->event._coroutines)
+        {
+            return;
+        }
+
+        // The ones that wait again while resumed wait for the next frame
+        INTERNAL_coroutines &_coroutines = *window->event._coroutines;
+        _coroutines._resuming.swap(_coroutines._frame_waiters);
+
+        for (std::coroutine_handle<> _handle : _coroutines._resuming)
+        {
+            _handle.resume();
+        }
+
+        _coroutines._resuming.clear();
+    }
+
+    void INTERNAL_resume_event_waiters(window *window, const event &event)
+    {
+        if (!window->event._coroutines)
+        {
+            return;
+        }
+
+        INTERNAL_coroutines &_coroutines = *window->event._coroutines;
+
+        // Taking the waiters out first, the ones that wait again while resumed wait for the next event
+        std::vector<event_waiter>::iterator _end = std::stable_partition(_coroutines._event_waiters.begin(), _coroutines._event_waiters.end(),
+                                                                         [&event](const event_waiter &waiter) { return !(waiter._awaiter->_filter & event.type); });
+        _coroutines._event_resuming.assign(_end, _coroutines._event_waiters.end());
+        _coroutines._event_waiters.erase(_end, _coroutines._event_waiters.end());
+
+        for (event_waiter &_waiter : _coroutines._event_resuming)
+        {
+            _waiter._awaiter->_event = event;
+            _waiter._handle.resume();
+        }
+
+        _coroutines._event_resuming.clear();
+    }
+
+    void INTERNAL_resume_timers(window *window)
+    {
+        if (!window->event._coroutines)
+        {
+            return;
+        }
+
+        std::vector<timer> &_timers = window->event._coroutines->_timers;
+        long long _now = now();
+
+        // Timers added while resuming have deadlines after now, so they wait
+        while (!_timers.empty() && _timers.front()._deadline <= _now)
+        {
+            std::pop_heap(_timers.begin(), _timers.end(), later);
+            std::coroutine_handle<> _handle = _timers.back()._handle;
+            _timers.pop_back();
+            _handle.resume();
+        }
+    }
+
+    int INTERNAL_clamp_to_timers(window *window, int timeout)
+    {
+        if (!window->event._coroutines || window->event._coroutines->_timers.empty())
+        {
+            return timeout;
+        }
+
+        // Rounded up, a wake up just before the deadline would only wait again
+        long long _left = window->event._coroutines->_timers.front()._deadline - now();
+        long long _milliseconds = _left > 0 ? (_left + 999999) / 1000000 : 0;
+
+        if (timeout >= 0 && timeout < _milliseconds)
+        {
+            return timeout;
+        }
+
+        return _milliseconds < INT_MAX ? static_cast<int>(_milliseconds) : INT_MAX;
+    }
+
+    void INTERNAL_destroy_coroutines(window *window)
+    {
+        INTERNAL_coroutines *_coroutines = window->event._coroutines;
+        if (!_coroutines)
+        {
+            return;
+        }
+
+        // Every suspended coroutine waits in only one of them
+        for (std::coroutine_handle<> _handle : _coroutines->_frame_waiters)
+        {
+            _handle.destroy();
+        }
+
+        for (event_waiter &_waiter : _coroutines->_event_waiters)
+        {
+            _waiter._handle.destroy();
+        }
+
+        for (timer &_timer : _coroutines->_timers)
+        {
+            _timer._handle.destroy();
+        }
+
+        delete _coroutines;
+        window->event._coroutines = nullptr;
+    }
+} // namespace PCFW
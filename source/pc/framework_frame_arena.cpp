@@ -0,0 +1,247 @@
+// Author: oknauta
+// License: MIT
+// File: framework_frame_arena.cpp
+// Date: 2026-10-19
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    struct arena_block
+    {
+        unsigned char *_data;
+        size_t _size;
+        size_t _used;
+    };
+
+    // The memory of one frame. Only the last block is bumped, the others are full
+    struct arena_buffer
+    {
+        std::vector<arena_block> _blocks;
+        // Bytes given this frame, with the alignment padding
+        size_t _used;
+    };
+
+    // Used only by its thread, except `_high_water` that `get_frame_arena_high_water` reads
+    struct INTERNAL_frame_arena
+    {
+        std::thread::id _thread;
+        arena_buffer _buffers[2];
+        int _current;
+        // The frame `_current` belongs to
+        unsigned long long _frame;
+        std::atomic<size_t> _high_water;
+    };
+
+    // The arena the thread used last. Most threads allocate for a single window, so one is enough
+    struct arena_cache
+    {
+        const window *_window;
+        unsigned long long _id;
+        INTERNAL_frame_arena *_arena;
+    };
+
+    static std::atomic<unsigned long long> _next_id{1};
+    static thread_local arena_cache _cache = {};
+
+    static void free_blocks(arena_buffer &buffer)
+    {
+        for (arena_block &_block : buffer._blocks)
+        {
+            free(_block._data);
+        }
+
+        buffer._blocks.clear();
+    }
+
+    // Frames that needed more blocks get a single one as big as all of them, so the next ones are bumps again
+    static void reset(arena_buffer &buffer)
+    {
+        if (buffer._blocks.size() > 1)
+        {
+            size_t _size = 0;
+            for (const arena_block &_block : buffer._blocks)
+            {
+                _size += _block._size;
+            }
+
+            free_blocks(buffer);
+
+            arena_block _block = {static_cast<unsigned char *>(malloc(_size)), _size, 0};
+            if (_block._data)
+            {
+                buffer._blocks.push_back(_block);
+            }
+        }
+        else if (!buffer._blocks.empty())
+        {
+            buffer._blocks.front()._used = 0;
+        }
+
+        buffer._used = 0;
+    }
+
+    static void *bump(arena_buffer &buffer, size_t size, size_t alignment)
+    {
+        arena_block &_block = buffer._blocks.back();
+
+        uintptr_t _address = reinterpret_cast<uintptr_t>(_block._data) + _block._used;
+        size_t _padding = (alignment - _address % alignment) % alignment;
+
+        if (_padding + size > _block._size - _block._used)
+        {
+            return nullptr;
+        }
+
+        void *_memory = _block._data + _block._used + _padding;
+        _block._used += _padding + size;
+        buffer._used += _padding + size;
+
+        return _memory;
+    }
+
+    static INTERNAL_frame_arena *find_arena(window *window)
+    {
+        INTERNAL_frame_arenas &_arenas = window->config._frame_arenas;
+
+        if (_cache._window == window && _cache._id == _arenas._id)
+        {
+            return _cache._arena;
+        }
+
+        std::thread::id _thread = std::this_thread::get_id();
+        INTERNAL_frame_arena *_arena = nullptr;
+
+        std::lock_guard<std::mutex> _lock(_arenas._mutex);
+        for (INTERNAL_frame_arena *_candidate : _arenas._arenas)
+        {
+            if (_candidate->_thread == _thread)
+            {
+                _arena = _candidate;
+                break;
+            }
+        }
+
+        // Arenas of finished threads stay with the window, a new thread with the same id takes them over
+        if (!_arena)
+        {
+            _arena = new INTERNAL_frame_arena{};
+            _arena->_thread = _thread;
+            _arena->_frame = ~0ULL;
+            _arenas._arenas.push_back(_arena);
+        }
+
+        _cache = {window, _arenas._id, _arena};
+        return _arena;
+    }
+
+    void INTERNAL_init_frame_arenas(window *window)
+    {
+        INTERNAL_frame_arenas &_arenas = window->config._frame_arenas;
+
+        _arenas._id = _next_id.fetch_add(1, std::memory_order_relaxed);
+        _arenas._block_size = FRAME_ARENA_BLOCK;
+        _arenas._buffers = 1;
+    }
+
+    void INTERNAL_free_frame_arenas(window *window)
+    {
+        INTERNAL_frame_arenas &_arenas = window->config._frame_arenas;
+
+        for (INTERNAL_frame_arena *_arena : _arenas._arenas)
+        {
+            free_blocks(_arena->_buffers[0]);
+            free_blocks(_arena->_buffers[1]);
+            delete _arena;
+        }
+
+        _arenas._arenas.clear();
+    }
+
+    int INTERNAL_set_frame_arena(window *window, size_t block_size, int buffers)
+    {
+        INTERNAL_frame_arenas &_arenas = window->config._frame_arenas;
+
+        // The threads read the settings without the lock, after they got their arena with it
+        std::lock_guard<std::mutex> _lock(_arenas._mutex);
+        if (!_arenas._arenas.empty())
+        {
+            Log::error("PCFW Internal: The frame arena must be set before the first allocation");
+            return 1;
+        }
+
+        _arenas._block_size = block_size;
+        _arenas._buffers = buffers;
+        return 0;
+    }
+
+    void *INTERNAL_frame_alloc(window *window, size_t size, size_t alignment)
+    {
+        INTERNAL_frame_arenas &_arenas = window->config._frame_arenas;
+        INTERNAL_frame_arena *_arena = find_arena(window);
+
+        unsigned long long _frame = _arenas._frame.load(std::memory_order_acquire);
+        if (_arena->_frame != _frame)
+        {
+            // With two buffers, the other one keeps the previous frame until the next swap
+            _arena->_frame = _frame;
+            _arena->_current = static_cast<int>(_frame % _arenas._buffers);
+            reset(_arena->_buffers[_arena->_current]);
+        }
+
+        arena_buffer &_buffer = _arena->_buffers[_arena->_current];
+
+        void *_memory = _buffer._blocks.empty() ? nullptr : bump(_buffer, size, alignment);
+        if (!_memory)
+        {
+            size_t _size = _buffer._blocks.empty() ? _arenas._block_size : _buffer._blocks.back()._size * 2;
+            if (_size < size + alignment)
+            {
+                _size = size + alignment;
+            }
+
+            arena_block _block = {static_cast<unsigned char *>(malloc(_size)), _size, 0};
+            if (!_block._data)
+            {
+                Log::error("PCFW Internal: Failed to allocate a block of %zu bytes for the frame arena", _size);
+                return nullptr;
+            }
+
+            _buffer._blocks.push_back(_block);
+            _memory = bump(_buffer, size, alignment);
+        }
+
+        if (_buffer._used > _arena->_high_water.load(std::memory_order_relaxed))
+        {
+            _arena->_high_water.store(_buffer._used, std::memory_order_relaxed);
+        }
+
+        return _memory;
+    }
+
+    int INTERNAL_get_frame_arena_high_water(window *window, size_t *bytes)
+    {
+        INTERNAL_frame_arenas &_arenas = window->config._frame_arenas;
+
+        size_t _high_water = 0;
+
+        std::lock_guard<std::mutex> _lock(_arenas._mutex);
+        for (const INTERNAL_frame_arena *_arena : _arenas._arenas)
+        {
+            size_t _used = _arena->_high_water.load(std::memory_order_relaxed);
+            if (_used > _high_water)
+            {
+                _high_water = _used;
+            }
+        }
+
+        *bytes = _high_water;
+        return 0;
+    }
+} // namespace PCFW
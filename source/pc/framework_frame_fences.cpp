@@ -0,0 +1,142 @@
+// Author: oknauta
+// License: MIT
+// File: framework_frame_fences.cpp
+// Date: 2026-10-19
+
+#ifdef __linux__
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <ctime>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    // How long a fence is waited before the GPU is considered lost and the fence dropped, in nanoseconds
+    constexpr GLuint64 FRAME_FENCE_TIMEOUT = 1000000000;
+
+    struct INTERNAL_frame_fences
+    {
+        // Fences of the frames still in flight, from the oldest
+        GLsync _fences[FRAMES_IN_FLIGHT_MAX];
+        int _first;
+        int _count;
+        int _max;
+
+        // How long the last swap waited
+        double _wait_time;
+    };
+
+    static long long monotonic_time()
+    {
+        timespec _time;
+        clock_gettime(CLOCK_MONOTONIC, &_time);
+        return _time.tv_sec * 1000000000LL + _time.tv_nsec;
+    }
+
+    static void delete_fences(const INTERNAL_gl &gl, INTERNAL_frame_fences *fences)
+    {
+        for (int i = 0; i < fences->_count; i++)
+        {
+            gl._delete_sync(fences->_fences[(fences->_first + i) % FRAMES_IN_FLIGHT_MAX]);
+        }
+
+        fences->_first = 0;
+        fences->_count = 0;
+    }
+
+    void INTERNAL_fence_frame(window *window)
+    {
+        INTERNAL_frame_fences *_fences = window->internal._frame_fences;
+        if (!_fences)
+        {
+            return;
+        }
+
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+
+        GLsync _fence = _gl._fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        if (_fence)
+        {
+            _fences->_fences[(_fences->_first + _fences->_count) % FRAMES_IN_FLIGHT_MAX] = _fence;
+            _fences->_count++;
+        }
+
+        PCFW_TRACE_SCOPE("wait_frame_fence");
+
+        long long _begin = monotonic_time();
+
+        // With `_max` frames in flight, the one about to begin can only start once the older ones leave room for it
+        while (_fences->_count >= _fences->_max)
+        {
+            GLsync _oldest = _fences->_fences[_fences->_first];
+
+            // The flush makes sure the fence reaches the GPU, otherwise the wait could never end
+            GLenum _result = _gl._client_wait_sync(_oldest, GL_SYNC_FLUSH_COMMANDS_BIT, FRAME_FENCE_TIMEOUT);
+            if (_result == GL_TIMEOUT_EXPIRED || _result == GL_WAIT_FAILED)
+            {
+                Log::error("PCFW Internal: A frame fence wasn't signaled, it's dropped");
+            }
+
+            _gl._delete_sync(_oldest);
+            _fences->_first = (_fences->_first + 1) % FRAMES_IN_FLIGHT_MAX;
+            _fences->_count--;
+        }
+
+        _fences->_wait_time = static_cast<double>(monotonic_time() - _begin) / 1e6;
+    }
+
+    void INTERNAL_free_frame_fences(window *window)
+    {
+        delete window->internal._frame_fences;
+        window->internal._frame_fences = nullptr;
+    }
+
+    int INTERNAL_set_max_frames_in_flight(window *window, int frames)
+    {
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+        INTERNAL_frame_fences *_fences = window->internal._frame_fences;
+
+        if (frames == 0)
+        {
+            if (_fences)
+            {
+                delete_fences(_gl, _fences);
+                INTERNAL_free_frame_fences(window);
+            }
+
+            return 0;
+        }
+
+        if (!_gl._fence_sync || !_gl._client_wait_sync || !_gl._delete_sync)
+        {
+            Log::error("PCFW Internal: The context has no sync objects");
+            return 1;
+        }
+
+        if (!_fences)
+        {
+            _fences = new INTERNAL_frame_fences{};
+            window->internal._frame_fences = _fences;
+        }
+
+        // A lower limit is reached by the next swap, it waits for as many fences as needed
+        _fences->_max = frames;
+        return 0;
+    }
+
+    int INTERNAL_get_frame_fence_wait(window *window, double *milliseconds)
+    {
+        INTERNAL_frame_fences *_fences = window->internal._frame_fences;
+        if (!_fences)
+        {
+            return 1;
+        }
+
+        *milliseconds = _fences->_wait_time;
+        return 0;
+    }
+} // namespace PCFW
+
+#endif
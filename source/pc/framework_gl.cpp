@@ -0,0 +1,87 @@
+// Author: oknauta
+// License: MIT
+// File: framework_gl.cpp
+// Date: 2026-10-19
+
+#ifdef __linux__
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <atomic>
+#include <mutex>
+
+namespace PC::Framework
+{
+    template <typename function>
+    static void load(function &pointer, const char *name)
+    {
+        pointer = reinterpret_cast<function>(INTERNAL_get_proc_address(name));
+    }
+
+    static INTERNAL_gl load_table()
+    {
+        INTERNAL_gl _table = {};
+        load(_table._get_string, "glGetString");
+        load(_table._get_integerv, "glGetIntegerv");
+        load(_table._create_program, "glCreateProgram");
+        load(_table._delete_program, "glDeleteProgram");
+        load(_table._get_programiv, "glGetProgramiv");
+        load(_table._get_program_binary, "glGetProgramBinary");
+        load(_table._program_binary, "glProgramBinary");
+        load(_table._gen_queries, "glGenQueries");
+        load(_table._delete_queries, "glDeleteQueries");
+        load(_table._query_counter, "glQueryCounter");
+        load(_table._get_query_objectiv, "glGetQueryObjectiv");
+        load(_table._get_query_objectui64v, "glGetQueryObjectui64v");
+        load(_table._use_program, "glUseProgram");
+        load(_table._bind_vertex_array, "glBindVertexArray");
+        load(_table._active_texture, "glActiveTexture");
+        load(_table._bind_texture, "glBindTexture");
+        load(_table._uniform1i, "glUniform1i");
+        load(_table._uniform1fv, "glUniform1fv");
+        load(_table._uniform2fv, "glUniform2fv");
+        load(_table._uniform3fv, "glUniform3fv");
+        load(_table._uniform4fv, "glUniform4fv");
+        load(_table._uniform_matrix4fv, "glUniformMatrix4fv");
+        load(_table._viewport, "glViewport");
+        load(_table._draw_arrays, "glDrawArrays");
+        load(_table._draw_arrays_instanced, "glDrawArraysInstanced");
+        load(_table._draw_elements, "glDrawElements");
+        load(_table._draw_elements_instanced, "glDrawElementsInstanced");
+        load(_table._fence_sync, "glFenceSync");
+        load(_table._client_wait_sync, "glClientWaitSync");
+        load(_table._delete_sync, "glDeleteSync");
+        return _table;
+    }
+
+    const INTERNAL_gl &INTERNAL_load_gl()
+    {
+        // GLX and EGL give the same addresses for every context of their library, so there's a table per backend.
+        // It's kept once its library is open, before that the calls get a table of `nullptr` and load it again
+        static const INTERNAL_gl _missing = {};
+        static std::mutex _mutex;
+        static INTERNAL_gl _tables[2];
+        static std::atomic<bool> _loaded[2];
+
+        int _backend = INTERNAL_get_current_backend();
+        if (!_loaded[_backend].load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> _lock(_mutex);
+            if (!_loaded[_backend].load(std::memory_order_relaxed))
+            {
+                INTERNAL_gl _table = load_table();
+                if (!_table._get_string)
+                {
+                    return _missing;
+                }
+
+                _tables[_backend] = _table;
+                _loaded[_backend].store(true, std::memory_order_release);
+            }
+        }
+
+        return _tables[_backend];
+    }
+} // namespace PCFW
+
+#endif
@@ -0,0 +1,294 @@
+// Author: oknauta
+// License: MIT
+// File: framework_gpu_timer.cpp
+// Date: 2026-10-19
+
+#ifdef __linux__
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <cstdio>
+#include <cstring>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    // Frames the GPU may be behind before one is skipped. Results are read this many frames late
+    constexpr int GPU_TIMER_FRAMES = 4;
+    // Scopes measured in a frame, the ones after it are ignored
+    constexpr int GPU_TIMER_SCOPES = 16;
+    constexpr int GPU_SCOPE_NAME = 32;
+
+    struct gpu_scope
+    {
+        char _name[GPU_SCOPE_NAME];
+        // Begin and end timestamps
+        GLuint _queries[2];
+        double _time;
+    };
+
+    struct gpu_frame
+    {
+        GLuint _queries[2];
+        gpu_scope _scopes[GPU_TIMER_SCOPES];
+        int _scope_count;
+        // The end timestamp was written and its result wasn't read yet
+        bool _pending;
+    };
+
+    struct INTERNAL_gpu_timer
+    {
+        gpu_frame _frames[GPU_TIMER_FRAMES];
+        // The frame being recorded, and if its begin timestamp was written
+        int _current;
+        bool _recording;
+
+        // Scopes begun and not ended, `-1` for the ignored ones
+        int _stack[GPU_TIMER_SCOPES];
+        int _depth;
+
+        // The last frame whose results arrived
+        bool _has_result;
+        double _frame_time;
+        gpu_scope _scopes[GPU_TIMER_SCOPES];
+        int _scope_count;
+    };
+
+    static double elapsed(const INTERNAL_gl &gl, const GLuint *queries)
+    {
+        GLuint64 _begin = 0;
+        GLuint64 _end = 0;
+        gl._get_query_objectui64v(queries[0], GL_QUERY_RESULT, &_begin);
+        gl._get_query_objectui64v(queries[1], GL_QUERY_RESULT, &_end);
+
+        return static_cast<double>(_end - _begin) / 1e6;
+    }
+
+    // Reads a frame if its end timestamp is there. The GPU writes them in order, so the others are there too
+    static bool collect(INTERNAL_gpu_timer *timer, gpu_frame &frame)
+    {
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+
+        GLint _available = GL_FALSE;
+        _gl._get_query_objectiv(frame._queries[1], GL_QUERY_RESULT_AVAILABLE, &_available);
+        if (!_available)
+        {
+            return false;
+        }
+
+        timer->_frame_time = elapsed(_gl, frame._queries);
+
+        for (int i = 0; i < frame._scope_count; i++)
+        {
+            frame._scopes[i]._time = elapsed(_gl, frame._scopes[i]._queries);
+            timer->_scopes[i] = frame._scopes[i];
+        }
+
+        timer->_scope_count = frame._scope_count;
+        timer->_has_result = true;
+        frame._pending = false;
+
+        return true;
+    }
+
+    static void close_scope(INTERNAL_gpu_timer *timer)
+    {
+        int _scope = timer->_stack[--timer->_depth];
+        if (_scope >= 0)
+        {
+            INTERNAL_load_gl()._query_counter(timer->_frames[timer->_current]._scopes[_scope]._queries[1], GL_TIMESTAMP);
+        }
+    }
+
+    void INTERNAL_gpu_timer_begin_frame(window *window)
+    {
+        INTERNAL_gpu_timer *_timer = window->internal._gpu_timer;
+        if (!_timer)
+        {
+            return;
+        }
+
+        gpu_frame &_frame = _timer->_frames[_timer->_current];
+
+        // The GPU is so far behind that the slot is still in use, this frame isn't measured instead of waiting
+        if (_frame._pending && !collect(_timer, _frame))
+        {
+            _timer->_recording = false;
+            return;
+        }
+
+        INTERNAL_load_gl()._query_counter(_frame._queries[0], GL_TIMESTAMP);
+        _frame._scope_count = 0;
+        _timer->_recording = true;
+    }
+
+    void INTERNAL_gpu_timer_end_frame(window *window)
+    {
+        INTERNAL_gpu_timer *_timer = window->internal._gpu_timer;
+        if (!_timer)
+        {
+            return;
+        }
+
+        while (_timer->_depth > 0)
+        {
+            close_scope(_timer);
+        }
+
+        if (_timer->_recording)
+        {
+            gpu_frame &_frame = _timer->_frames[_timer->_current];
+            INTERNAL_load_gl()._query_counter(_frame._queries[1], GL_TIMESTAMP);
+            _frame._pending = true;
+            _timer->_recording = false;
+        }
+
+        _timer->_current = (_timer->_current + 1) % GPU_TIMER_FRAMES;
+
+        // Reading the frames that have finished, from the oldest
+        for (int i = 0; i < GPU_TIMER_FRAMES; i++)
+        {
+            gpu_frame &_frame = _timer->_frames[(_timer->_current + i) % GPU_TIMER_FRAMES];
+            if (_frame._pending && !collect(_timer, _frame))
+            {
+                break;
+            }
+        }
+    }
+
+    void INTERNAL_free_gpu_timer(window *window)
+    {
+        delete window->internal._gpu_timer;
+        window->internal._gpu_timer = nullptr;
+    }
+
+    int INTERNAL_set_gpu_timing(window *window, int enabled)
+    {
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+        INTERNAL_gpu_timer *_timer = window->internal._gpu_timer;
+
+        if (!enabled)
+        {
+            if (_timer)
+            {
+                for (gpu_frame &_frame : _timer->_frames)
+                {
+                    _gl._delete_queries(2, _frame._queries);
+                    for (gpu_scope &_scope : _frame._scopes)
+                    {
+                        _gl._delete_queries(2, _scope._queries);
+                    }
+                }
+
+                INTERNAL_free_gpu_timer(window);
+            }
+
+            return 0;
+        }
+
+        if (_timer)
+        {
+            return 0;
+        }
+
+        if (!_gl._gen_queries || !_gl._query_counter || !_gl._get_query_objectiv || !_gl._get_query_objectui64v)
+        {
+            Log::error("PCFW Internal: The context has no timestamp queries");
+            return 1;
+        }
+
+        _timer = new INTERNAL_gpu_timer{};
+        for (gpu_frame &_frame : _timer->_frames)
+        {
+            _gl._gen_queries(2, _frame._queries);
+            for (gpu_scope &_scope : _frame._scopes)
+            {
+                _gl._gen_queries(2, _scope._queries);
+            }
+        }
+
+        window->internal._gpu_timer = _timer;
+
+        // The frame being rendered now is the first one
+        INTERNAL_gpu_timer_begin_frame(window);
+        return 0;
+    }
+
+    int INTERNAL_begin_gpu_scope(window *window, const char *name)
+    {
+        INTERNAL_gpu_timer *_timer = window->internal._gpu_timer;
+        if (!_timer)
+        {
+            Log::error("PCFW Internal: The GPU timing is off");
+            return 1;
+        }
+
+        if (_timer->_depth == GPU_TIMER_SCOPES)
+        {
+            Log::error("PCFW Internal: Too many nested GPU scopes");
+            return 1;
+        }
+
+        gpu_frame &_frame = _timer->_frames[_timer->_current];
+
+        // Skipped frames and scopes past the limit are still nested, so `end_gpu_scope` matches
+        int _scope = -1;
+        if (_timer->_recording && _frame._scope_count < GPU_TIMER_SCOPES)
+        {
+            _scope = _frame._scope_count++;
+            snprintf(_frame._scopes[_scope]._name, GPU_SCOPE_NAME, "%s", name);
+            INTERNAL_load_gl()._query_counter(_frame._scopes[_scope]._queries[0], GL_TIMESTAMP);
+        }
+
+        _timer->_stack[_timer->_depth++] = _scope;
+        return 0;
+    }
+
+    int INTERNAL_end_gpu_scope(window *window)
+    {
+        INTERNAL_gpu_timer *_timer = window->internal._gpu_timer;
+        if (!_timer || _timer->_depth == 0)
+        {
+            Log::error("PCFW Internal: No GPU scope to end");
+            return 1;
+        }
+
+        close_scope(_timer);
+        return 0;
+    }
+
+    int INTERNAL_get_gpu_frame_time(window *window, double *milliseconds)
+    {
+        INTERNAL_gpu_timer *_timer = window->internal._gpu_timer;
+        if (!_timer || !_timer->_has_result)
+        {
+            return 1;
+        }
+
+        *milliseconds = _timer->_frame_time;
+        return 0;
+    }
+
+    int INTERNAL_get_gpu_scope_time(window *window, const char *name, double *milliseconds)
+    {
+        INTERNAL_gpu_timer *_timer = window->internal._gpu_timer;
+        if (!_timer)
+        {
+            return 1;
+        }
+
+        for (int i = 0; i < _timer->_scope_count; i++)
+        {
+            if (strncmp(_timer->_scopes[i]._name, name, GPU_SCOPE_NAME - 1) == 0)
+            {
+                *milliseconds = _timer->_scopes[i]._time;
+                return 0;
+            }
+        }
+
+        return 1;
+    }
+} // namespace PCFW
+
+#endif
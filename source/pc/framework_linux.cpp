@@ -5,13 +5,35 @@
 
 #ifdef __linux__
 
+#ifdef PCFW_VULKAN
+#define VK_USE_PLATFORM_XLIB_KHR
+#include <vulkan/vulkan.h>
+#endif
+
 #include "pc/framework.hpp"
 #include "pc/framework_internal.hpp"
 #include <GL/gl.h>
 #include <GL/glx.h>
 #include <X11/Xlib.h>
+#include <X11/Xlib-xcb.h>
 #include <X11/Xutil.h>
+#include <X11/Xatom.h>
+#include <X11/extensions/Xrandr.h>
+#include <X11/extensions/sync.h>
 #include <X11/X.h>
+#include <xcb/xcb.h>
+#include <dlfcn.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 
 #include <pc/log.hpp>
 
@@ -86,7 +108,393 @@ namespace PC::Framework
     constexpr int KEY_Y = 29;
     constexpr int KEY_Z = 52;
 
+    // Frames per second of the windows that can't be seen, until `set_hidden_frame_rate`
+    constexpr double HIDDEN_FRAME_RATE = 10.0;
+
 	// Functions
+
+    // The backend of the last created window. `INTERNAL_get_proc_address` doesn't receive any window
+    static int _current_backend = BACKEND_X11;
+
+    // The X11 libraries aren't linked, they're opened at the first X11 window. Programs that never create one
+    // don't load them, and start on machines without them. The macros after the table keep the usual names
+
+#define PCFW_XLIB_FUNCTIONS(F) \
+    F(XAllocSizeHints) \
+    F(XChangeProperty) \
+    F(XChangeWindowAttributes) \
+    F(XCloseDisplay) \
+    F(XConvertSelection) \
+    F(XCreateColormap) \
+    F(XCreateWindow) \
+    F(XDeleteProperty) \
+    F(XDestroyWindow) \
+    F(XEventsQueued) \
+    F(XExtendedMaxRequestSize) \
+    F(XFlush) \
+    F(XFree) \
+    F(XFreeColormap) \
+    F(XGetSelectionOwner) \
+    F(XGetWindowAttributes) \
+    F(XGetWindowProperty) \
+    F(XMapWindow) \
+    F(XMaxRequestSize) \
+    F(XMoveResizeWindow) \
+    F(XNextEvent) \
+    F(XOpenDisplay) \
+    F(XPending) \
+    F(XSelectInput) \
+    F(XSendEvent) \
+    F(XSetErrorHandler) \
+    F(XSetNormalHints) \
+    F(XSetSelectionOwner) \
+    F(XSync) \
+    F(XTranslateCoordinates)
+
+#define PCFW_X11_XCB_FUNCTIONS(F) \
+    F(XGetXCBConnection)
+
+#define PCFW_XCB_FUNCTIONS(F) \
+    F(xcb_change_property) \
+    F(xcb_discard_reply) \
+    F(xcb_flush) \
+    F(xcb_intern_atom) \
+    F(xcb_intern_atom_reply) \
+    F(xcb_query_pointer) \
+    F(xcb_query_pointer_reply)
+
+#define PCFW_XRANDR_FUNCTIONS(F) \
+    F(XRRFreeCrtcInfo) \
+    F(XRRFreeOutputInfo) \
+    F(XRRFreeScreenResources) \
+    F(XRRGetCrtcInfo) \
+    F(XRRGetOutputInfo) \
+    F(XRRGetOutputPrimary) \
+    F(XRRGetScreenResourcesCurrent) \
+    F(XRRGetScreenSizeRange) \
+    F(XRRQueryExtension) \
+    F(XRRSelectInput) \
+    F(XRRSetCrtcConfig) \
+    F(XRRSetScreenSize) \
+    F(XRRUpdateConfiguration)
+
+#define PCFW_XSYNC_FUNCTIONS(F) \
+    F(XSyncCreateCounter) \
+    F(XSyncDestroyCounter) \
+    F(XSyncInitialize) \
+    F(XSyncIntsToValue) \
+    F(XSyncQueryExtension) \
+    F(XSyncSetCounter)
+
+#define PCFW_GLX_FUNCTIONS(F) \
+    F(glXChooseVisual) \
+    F(glXCreateContext) \
+    F(glXDestroyContext) \
+    F(glXGetProcAddress) \
+    F(glXMakeCurrent) \
+    F(glXSwapBuffers)
+
+#define PCFW_X11_POINTER(name) decltype(&::name) name;
+
+    struct x11_library
+    {
+        bool _loaded;
+        // The optional ones. Without them there are no monitors nor video modes, no resize sync, or no OpenGL windows
+        bool _xrandr;
+        bool _xsync;
+        bool _glx;
+
+        PCFW_XLIB_FUNCTIONS(PCFW_X11_POINTER)
+        PCFW_X11_XCB_FUNCTIONS(PCFW_X11_POINTER)
+        PCFW_XCB_FUNCTIONS(PCFW_X11_POINTER)
+        PCFW_XRANDR_FUNCTIONS(PCFW_X11_POINTER)
+        PCFW_XSYNC_FUNCTIONS(PCFW_X11_POINTER)
+        PCFW_GLX_FUNCTIONS(PCFW_X11_POINTER)
+    };
+
+#undef PCFW_X11_POINTER
+
+    static x11_library _x11;
+
+    void *INTERNAL_open_library(const char *const *names)
+    {
+        for (; *names; names++)
+        {
+            if (void *_library = dlopen(*names, RTLD_NOW | RTLD_LOCAL))
+            {
+                return _library;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Opens a library and resolves a list of its symbols. A library missing any of them isn't used
+#define PCFW_X11_RESOLVE(name) _resolved = (_x11.name = reinterpret_cast<decltype(_x11.name)>(dlsym(_library, #name))) && _resolved;
+#define PCFW_X11_LOAD(functions, ...) \
+    [] \
+    { \
+        static const char *const _names[] = {__VA_ARGS__, nullptr}; \
+        void *_library = INTERNAL_open_library(_names); \
+        if (!_library) \
+        { \
+            return false; \
+        } \
+        bool _resolved = true; \
+        functions(PCFW_X11_RESOLVE) \
+        if (!_resolved) \
+        { \
+            dlclose(_library); \
+        } \
+        return _resolved; \
+    }()
+
+    static bool load_x11()
+    {
+        if (_x11._loaded)
+        {
+            return true;
+        }
+
+        if (!PCFW_X11_LOAD(PCFW_XLIB_FUNCTIONS, "libX11.so.6", "libX11.so") || !PCFW_X11_LOAD(PCFW_X11_XCB_FUNCTIONS, "libX11-xcb.so.1", "libX11-xcb.so") ||
+            !PCFW_X11_LOAD(PCFW_XCB_FUNCTIONS, "libxcb.so.1", "libxcb.so"))
+        {
+            PC::Log::error("PCFW Internal: Failed to load libX11, libX11-xcb or libxcb");
+            return false;
+        }
+
+        _x11._xrandr = PCFW_X11_LOAD(PCFW_XRANDR_FUNCTIONS, "libXrandr.so.2", "libXrandr.so");
+        _x11._xsync = PCFW_X11_LOAD(PCFW_XSYNC_FUNCTIONS, "libXext.so.6", "libXext.so");
+        _x11._loaded = true;
+
+        return true;
+    }
+
+    // Only OpenGL windows open it, Vulkan and software windows don't need it
+    static bool load_glx()
+    {
+        if (!_x11._glx)
+        {
+            _x11._glx = PCFW_X11_LOAD(PCFW_GLX_FUNCTIONS, "libGL.so.1", "libGL.so");
+            if (!_x11._glx)
+            {
+                PC::Log::error("PCFW Internal: Failed to load libGL");
+            }
+        }
+
+        return _x11._glx;
+    }
+
+#undef PCFW_X11_LOAD
+#undef PCFW_X11_RESOLVE
+
+    // From here the X11 calls go through `_x11`
+#define XAllocSizeHints _x11.XAllocSizeHints
+#define XChangeProperty _x11.XChangeProperty
+#define XChangeWindowAttributes _x11.XChangeWindowAttributes
+#define XCloseDisplay _x11.XCloseDisplay
+#define XConvertSelection _x11.XConvertSelection
+#define XCreateColormap _x11.XCreateColormap
+#define XCreateWindow _x11.XCreateWindow
+#define XDeleteProperty _x11.XDeleteProperty
+#define XDestroyWindow _x11.XDestroyWindow
+#define XEventsQueued _x11.XEventsQueued
+#define XExtendedMaxRequestSize _x11.XExtendedMaxRequestSize
+#define XFlush _x11.XFlush
+#define XFree _x11.XFree
+#define XFreeColormap _x11.XFreeColormap
+#define XGetSelectionOwner _x11.XGetSelectionOwner
+#define XGetWindowAttributes _x11.XGetWindowAttributes
+#define XGetWindowProperty _x11.XGetWindowProperty
+#define XMapWindow _x11.XMapWindow
+#define XMaxRequestSize _x11.XMaxRequestSize
+#define XMoveResizeWindow _x11.XMoveResizeWindow
+#define XNextEvent _x11.XNextEvent
+#define XOpenDisplay _x11.XOpenDisplay
+#define XPending _x11.XPending
+#define XSelectInput _x11.XSelectInput
+#define XSendEvent _x11.XSendEvent
+#define XSetErrorHandler _x11.XSetErrorHandler
+#define XSetNormalHints _x11.XSetNormalHints
+#define XSetSelectionOwner _x11.XSetSelectionOwner
+#define XSync _x11.XSync
+#define XTranslateCoordinates _x11.XTranslateCoordinates
+#define XGetXCBConnection _x11.XGetXCBConnection
+#define xcb_change_property _x11.xcb_change_property
+#define xcb_discard_reply _x11.xcb_discard_reply
+#define xcb_flush _x11.xcb_flush
+#define xcb_intern_atom _x11.xcb_intern_atom
+#define xcb_intern_atom_reply _x11.xcb_intern_atom_reply
+#define xcb_query_pointer _x11.xcb_query_pointer
+#define xcb_query_pointer_reply _x11.xcb_query_pointer_reply
+#define XRRFreeCrtcInfo _x11.XRRFreeCrtcInfo
+#define XRRFreeOutputInfo _x11.XRRFreeOutputInfo
+#define XRRFreeScreenResources _x11.XRRFreeScreenResources
+#define XRRGetCrtcInfo _x11.XRRGetCrtcInfo
+#define XRRGetOutputInfo _x11.XRRGetOutputInfo
+#define XRRGetOutputPrimary _x11.XRRGetOutputPrimary
+#define XRRGetScreenResourcesCurrent _x11.XRRGetScreenResourcesCurrent
+#define XRRGetScreenSizeRange _x11.XRRGetScreenSizeRange
+#define XRRQueryExtension _x11.XRRQueryExtension
+#define XRRSelectInput _x11.XRRSelectInput
+#define XRRSetCrtcConfig _x11.XRRSetCrtcConfig
+#define XRRSetScreenSize _x11.XRRSetScreenSize
+#define XRRUpdateConfiguration _x11.XRRUpdateConfiguration
+#define XSyncCreateCounter _x11.XSyncCreateCounter
+#define XSyncDestroyCounter _x11.XSyncDestroyCounter
+#define XSyncInitialize _x11.XSyncInitialize
+#define XSyncIntsToValue _x11.XSyncIntsToValue
+#define XSyncQueryExtension _x11.XSyncQueryExtension
+#define XSyncSetCounter _x11.XSyncSetCounter
+#define glXChooseVisual _x11.glXChooseVisual
+#define glXCreateContext _x11.glXCreateContext
+#define glXDestroyContext _x11.glXDestroyContext
+#define glXGetProcAddress _x11.glXGetProcAddress
+#define glXMakeCurrent _x11.glXMakeCurrent
+#define glXSwapBuffers _x11.glXSwapBuffers
+
+    // Names of `INTERNAL_atom`, in the same order
+    static const char *_atom_names[ATOM_COUNT]
+    {
+        "WM_PROTOCOLS",
+        "WM_DELETE_WINDOW",
+        "_NET_WM_NAME",
+        "UTF8_STRING",
+        "CLIPBOARD",
+        "TARGETS",
+        "INCR",
+        "PCFW_SELECTION",
+        "_NET_WM_STATE",
+        "_NET_WM_STATE_FULLSCREEN",
+        "_NET_WM_STATE_HIDDEN",
+        "_NET_WM_BYPASS_COMPOSITOR",
+        "_NET_WM_SYNC_REQUEST",
+        "_NET_WM_SYNC_REQUEST_COUNTER",
+        "_NET_FRAME_EXTENTS"
+    };
+
+    // Sends every intern request at once. The replies are collected by `receive_atoms`
+    static void request_atoms(window *window, xcb_intern_atom_cookie_t *cookies)
+    {
+        for (int i = 0; i < ATOM_COUNT; i++)
+        {
+            cookies[i] = xcb_intern_atom(window->internal._connection, 0, strlen(_atom_names[i]), _atom_names[i]);
+        }
+    }
+
+    static int receive_atoms(window *window, xcb_intern_atom_cookie_t *cookies)
+    {
+        int _result = 0;
+
+        for (int i = 0; i < ATOM_COUNT; i++)
+        {
+            xcb_intern_atom_reply_t *_reply = xcb_intern_atom_reply(window->internal._connection, cookies[i], nullptr);
+            if (!_reply)
+            {
+                PC::Log::error("PCFW Internal: Failed to intern atom %s", _atom_names[i]);
+                window->internal._atoms[i] = None;
+                _result = 1;
+                continue;
+            }
+
+            window->internal._atoms[i] = _reply->atom;
+            free(_reply);
+        }
+
+        return _result;
+    }
+
+    // The X events of the categories subscribed and of the callbacks that are set
+    static long event_mask(window *window)
+    {
+        // The size, the clipboard, the fullscreen state and the visibility always need these
+        long _mask = StructureNotifyMask | PropertyChangeMask | VisibilityChangeMask;
+
+        int _events = window->config._events;
+
+        if (window->event._key_callback)
+        {
+            _events |= EVENTS_KEY;
+        }
+
+        if (window->event._mouse_callback)
+        {
+            _events |= EVENTS_MOUSE_BUTTON;
+        }
+
+        // Loops drawn on demand need the exposes, or a damaged window stays damaged until something else wakes them up
+        if (window->event._refresh_callback || window->internal._on_demand)
+        {
+            _events |= EVENTS_EXPOSE;
+        }
+
+        if (_events & EVENTS_KEY)
+        {
+            _mask |= KeyPressMask | KeyReleaseMask;
+        }
+
+        if (_events & EVENTS_MOUSE_BUTTON)
+        {
+            _mask |= ButtonPressMask | ButtonReleaseMask;
+        }
+
+        if (_events & EVENTS_MOUSE_MOTION)
+        {
+            _mask |= PointerMotionMask;
+        }
+
+        if (_events & EVENTS_ENTER_LEAVE)
+        {
+            _mask |= EnterWindowMask | LeaveWindowMask;
+        }
+
+        if (_events & EVENTS_FOCUS)
+        {
+            _mask |= FocusChangeMask;
+        }
+
+        if (_events & EVENTS_EXPOSE)
+        {
+            _mask |= ExposureMask;
+        }
+
+        return _mask;
+    }
+
+    // Sends the event mask to the server, only when it changed
+    static void update_event_mask(window *window)
+    {
+        if (window->internal._backend != BACKEND_X11 || !window->internal._handle)
+        {
+            return;
+        }
+
+        long _mask = event_mask(window);
+        if (_mask == window->internal._attributes.event_mask)
+        {
+            return;
+        }
+
+        window->internal._attributes.event_mask = _mask;
+        XChangeWindowAttributes(window->internal._display, window->internal._handle, CWEventMask, &window->internal._attributes);
+        XFlush(window->internal._display);
+    }
+
+    int INTERNAL_set_window_refresh_callback(window *window, refresh_callback callback)
+    {
+        window->event._refresh_callback = callback;
+        update_event_mask(window);
+
+        return 0;
+    }
+
+    int INTERNAL_subscribe_events(window *window, int events)
+    {
+        window->config._events = events;
+        update_event_mask(window);
+
+        return 0;
+    }
 	
     	int INTERNAL_set_key_callback(window *window, key_callback callback)
 	{
@@ -98,6 +506,7 @@ namespace PC::Framework
 			return 1;
 		}
 
+		update_event_mask(window);
 		return 0;
 	}
 
@@ -124,22 +533,124 @@ namespace PC::Framework
             return 1;
         }
 
+        update_event_mask(window);
         return 0;
     }
 
+    // The first window of a scheduler blocks on the V-Sync for the others, so it keeps swapping while any of them can be seen
+    static bool paces_visible_windows(window *window)
+    {
+        scheduler *_scheduler = window->config._scheduler;
+        if (!_scheduler || _scheduler->_windows.front() != window)
+        {
+            return false;
+        }
+
+        for (struct window *_window : _scheduler->_windows)
+        {
+            if (_window != window && INTERNAL_get_window_visibility(_window) == VISIBILITY_VISIBLE)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     void INTERNAL_swap_buffers(window *window)
     {
-        glXSwapBuffers(window->internal._display, window->internal._handle);
+        PCFW_TRACE_SCOPE("swap_buffers");
+
+#ifdef PCFW_WAYLAND
+        if (window->internal._backend == BACKEND_WAYLAND)
+        {
+            WAYLAND_swap_buffers(window);
+            return;
+        }
+#endif
+        if (!window->internal._gl_context)
+        {
+            return;
+        }
+
+        // Nothing shows a minimized window. The answer to the window manager below still goes out
+        if (!window->internal._limiter._hidden_period || INTERNAL_get_window_visibility(window) != VISIBILITY_HIDDEN || paces_visible_windows(window))
+        {
+            glXSwapBuffers(window->internal._display, window->internal._handle);
+        }
+
+        // The frame of the new size is done, the window manager can resize again
+        if (window->internal._sync_configured)
+        {
+            XSyncSetCounter(window->internal._display, window->internal._sync_counter, window->internal._sync_value);
+            XFlush(window->internal._display);
+            window->internal._sync_requested = false;
+            window->internal._sync_configured = false;
+        }
+        else if (window->internal._sync_requested)
+        {
+            // No ConfigureNotify came, e.g. the size didn't change. The next swap answers, so the window manager isn't left waiting
+            window->internal._sync_configured = true;
+        }
     }
 
     int INTERNAL_create_window(window *window)
     {
+        PCFW_TRACE_SCOPE("create_window");
+
         if (!window)
         {
             PC::Log::error("PCFW Internal: No window to create");
             return 1;
         }
+
+        // Both backends poll it, and the first frame is always drawn
+        window->internal._wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (window->internal._wake_fd < 0)
+        {
+            PC::Log::error("PCFW Internal: Failed to create the eventfd of the redraws");
+            return 1;
+        }
+
+        window->event._redraw = true;
+        INTERNAL_set_hidden_frame_rate(window, HIDDEN_FRAME_RATE);
+
+#ifdef PCFW_WAYLAND
+        // `PCFW_BACKEND` can force a backend. Otherwise Wayland is tried when there's a Wayland session
+        const char *_backend = getenv("PCFW_BACKEND");
+        bool _force_wayland = _backend && strcmp(_backend, "wayland") == 0;
+        bool _force_x11 = _backend && strcmp(_backend, "x11") == 0;
+
+        // Vulkan surfaces are made from Xlib windows, so windows without OpenGL stay on X11
+        bool _no_api = window->config._client_api == CLIENT_API_NONE;
+
+        if (!_no_api && (_force_wayland || (!_force_x11 && getenv("WAYLAND_DISPLAY"))))
+        {
+            if (WAYLAND_create_window(window) == 0)
+            {
+                window->internal._backend = BACKEND_WAYLAND;
+                _current_backend = BACKEND_WAYLAND;
+                return 0;
+            }
+
+            if (_force_wayland)
+            {
+                return 1;
+            }
+
+            PC::Log::warning("PCFW Internal: Failed to create a Wayland window, falling back to X11");
+        }
+#endif
+
+        window->internal._backend = BACKEND_X11;
+        _current_backend = BACKEND_X11;
 	
+	// Opening the X11 libraries, only the first window does it
+        if (!load_x11())
+        {
+            return 1;
+        }
+
 	// Setting the display
         window->internal._display = XOpenDisplay(nullptr);
         if (!window->internal._display)
@@ -155,6 +666,20 @@ namespace PC::Framework
             PC::Log::error("PCFW Internal: Failed to set internal display");
             return 1;
         }
+
+	// XRandR is used for the monitors and the video modes
+        int _randr_error_base;
+        window->internal._randr = _x11._xrandr && XRRQueryExtension(window->internal._display, &window->internal._randr_event_base, &_randr_error_base);
+        if (window->internal._randr)
+        {
+            XRRSelectInput(window->internal._display, RootWindow(window->internal._display, window->internal._screen), RRScreenChangeNotifyMask | RRCrtcChangeNotifyMask | RROutputChangeNotifyMask);
+        }
+
+	// The atoms are interned while the visual and the context are being created
+        window->internal._connection = XGetXCBConnection(window->internal._display);
+
+        xcb_intern_atom_cookie_t _atom_cookies[ATOM_COUNT];
+        request_atoms(window, _atom_cookies);
 	
 
 	// The visual attributes. Such as if it will has double buffer, etc
@@ -167,12 +692,23 @@ namespace PC::Framework
             None
         };
 	
-	// Giving the visual information
-        window->internal._visual_info = glXChooseVisual(window->internal._display, window->internal._screen, _attributes);
-        if (!window->internal._visual_info)
+	// Giving the visual information. Windows without OpenGL use the default visual
+        Visual *_visual = DefaultVisual(window->internal._display, window->internal._screen);
+        if (window->config._client_api == CLIENT_API_OPENGL)
         {
-            PC::Log::error("PCFW Internal: Failed to set visual info");
-            return 1;
+            if (!load_glx())
+            {
+                return 1;
+            }
+
+            window->internal._visual_info = glXChooseVisual(window->internal._display, window->internal._screen, _attributes);
+            if (!window->internal._visual_info)
+            {
+                PC::Log::error("PCFW Internal: Failed to set visual info");
+                return 1;
+            }
+
+            _visual = window->internal._visual_info->visual;
         }
         
 	// Creating a root window to use later in "XCreateWindow"
@@ -183,39 +719,74 @@ namespace PC::Framework
 		return 1;
 	}
 
-	window->internal._attributes.colormap = XCreateColormap(window->internal._display, root, window->internal._visual_info->visual, AllocNone);
+	window->internal._attributes.colormap = XCreateColormap(window->internal._display, root, _visual, AllocNone);
         if (!window->internal._attributes.colormap)
         {
             PC::Log::error("PCFW Internal: Failed to set colormap");
             return 1;
         }
 
-	// Setting the event mask
-        window->internal._attributes.event_mask = ExposureMask | KeyPressMask | ButtonPress | StructureNotifyMask | ButtonReleaseMask | KeyReleaseMask | EnterWindowMask | LeaveWindowMask | PointerMotionMask | Button1MotionMask | VisibilityChangeMask | ColormapChangeMask;
+	// Setting the event mask. Only what is subscribed, `subscribe_events` and the callbacks change it later
+        window->internal._attributes.event_mask = event_mask(window);
 
         // Creating the context of the window. It's not like "make" the context
-        window->internal._gl_context = glXCreateContext(window->internal._display, window->internal._visual_info, nullptr, GL_TRUE);
-        if (!window->internal._gl_context)
+        if (window->config._client_api == CLIENT_API_OPENGL)
         {
-            PC::Log::error("PCFW Internal: Failed to create GLX context");
-            return 1;
+            window->internal._gl_context = glXCreateContext(window->internal._display, window->internal._visual_info, nullptr, GL_TRUE);
+            if (!window->internal._gl_context)
+            {
+                PC::Log::error("PCFW Internal: Failed to create GLX context");
+                return 1;
+            }
         }
 
 	// Creating the window with the parameters above 
-        window->internal._handle = XCreateWindow(window->internal._display, root, 0, 0, window->config._width, window->config._height, 0, CopyFromParent, InputOutput, window->internal._visual_info->visual, CWColormap | CWEventMask, &window->internal._attributes);
-
-	// Setting the parameter "WM_DELETE_WINDOW" to the window
-	window->internal._wm_delete_window = XInternAtom(window->internal._display, "WM_DELETE_WINDOW", 1);
-	XSetWMProtocols(window->internal._display, window->internal._handle, &window->internal._wm_delete_window, 1);
+        window->internal._handle = XCreateWindow(window->internal._display, root, 0, 0, window->config._width, window->config._height, 0, CopyFromParent, InputOutput, _visual, CWColormap | CWEventMask, &window->internal._attributes);
 
         if (!window->internal._handle)
         {
             PC::Log::error("PCFW Internal: Failed to create window");
             return 1;
         }
+
+        if (receive_atoms(window, _atom_cookies))
+        {
+            return 1;
+        }
+
+	// Setting the parameter "WM_DELETE_WINDOW" and the title to the window. None of them waits for a reply
+        xcb_connection_t *_connection = window->internal._connection;
+
+        // OpenGL windows also pace the resizes of the window manager with `_NET_WM_SYNC_REQUEST`. The others don't swap here, the window manager would wait for nothing
+        uint32_t _protocols[2] = {static_cast<uint32_t>(window->internal._atoms[ATOM_WM_DELETE_WINDOW]), static_cast<uint32_t>(window->internal._atoms[ATOM_NET_WM_SYNC_REQUEST])};
+        uint32_t _protocol_count = 1;
+
+        int _sync_event_base, _sync_error_base, _sync_major, _sync_minor;
+        if (window->internal._gl_context && _x11._xsync && XSyncQueryExtension(window->internal._display, &_sync_event_base, &_sync_error_base) && XSyncInitialize(window->internal._display, &_sync_major, &_sync_minor))
+        {
+            XSyncIntsToValue(&window->internal._sync_value, 0, 0);
+            window->internal._sync_counter = XSyncCreateCounter(window->internal._display, window->internal._sync_value);
+
+            if (window->internal._sync_counter)
+            {
+                uint32_t _counter = static_cast<uint32_t>(window->internal._sync_counter);
+                xcb_change_property(_connection, XCB_PROP_MODE_REPLACE, window->internal._handle, window->internal._atoms[ATOM_NET_WM_SYNC_REQUEST_COUNTER], XCB_ATOM_CARDINAL, 32, 1, &_counter);
+                _protocol_count = 2;
+            }
+        }
+
+        xcb_change_property(_connection, XCB_PROP_MODE_REPLACE, window->internal._handle, window->internal._atoms[ATOM_WM_PROTOCOLS], XCB_ATOM_ATOM, 32, _protocol_count, _protocols);
+
+        if (window->config._title)
+        {
+            uint32_t _length = strlen(window->config._title);
+            xcb_change_property(_connection, XCB_PROP_MODE_REPLACE, window->internal._handle, XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8, _length, window->config._title);
+            xcb_change_property(_connection, XCB_PROP_MODE_REPLACE, window->internal._handle, window->internal._atoms[ATOM_NET_WM_NAME], window->internal._atoms[ATOM_UTF8_STRING], 8, _length, window->config._title);
+        }
 	
-	// Showing the window
+	// Showing the window. It counts as mapped already, so the first frames aren't throttled while the MapNotify comes
         XMapWindow(window->internal._display, window->internal._handle);
+        window->internal._mapped = true;
         
 	// Updating the window
 	XFlush(window->internal._display);
@@ -224,130 +795,1496 @@ namespace PC::Framework
         return 0;
     }
 
-    int INTERNAL_destroy_window(window *window)
+    // Monitors and fullscreen
+
+    static double mode_refresh_rate(const XRRModeInfo &mode)
     {
-        if (window->internal._gl_context)
+        if (mode.hTotal == 0 || mode.vTotal == 0)
         {
-            glXMakeCurrent(window->internal._display, None, nullptr);
-            glXDestroyContext(window->internal._display, window->internal._gl_context);
+            return 0.0;
         }
 
-        if (window->internal._colormap)
-        {
-            XFreeColormap(window->internal._display, window->internal._colormap);
-        }
+        double _rate = static_cast<double>(mode.dotClock) / (static_cast<double>(mode.hTotal) * mode.vTotal);
 
-        if (window->internal._handle)
+        if (mode.modeFlags & RR_DoubleScan)
         {
-            XDestroyWindow(window->internal._display, window->internal._handle);
+            _rate /= 2.0;
         }
 
-        if (window->internal._display)
+        if (mode.modeFlags & RR_Interlace)
         {
-            XCloseDisplay(window->internal._display);
+            _rate *= 2.0;
         }
 
-        return 0;
+        return _rate;
     }
 
-    bool INTERNAL_window_should_close(window *window)
+    static const XRRModeInfo *find_mode(const XRRScreenResources *resources, RRMode mode)
     {
-        return window ? window->config._should_close : false;
+        for (int i = 0; i < resources->nmode; i++)
+        {
+            if (resources->modes[i].id == mode)
+            {
+                return &resources->modes[i];
+            }
+        }
+
+        return nullptr;
     }
 
-    static void handle_client_message(window *window)
+    // Queries the connected monitors again if XRandR has changed them, the primary one first
+    static void update_monitors(window *window)
     {
-        if (window->internal._event.xclient.data.l[0] == window->internal._wm_delete_window)
+        if (window->internal._monitors_valid)
         {
-            window->config._should_close = true;
+            return;
         }
-    }
 
-    static void handle_configure_notify(window *window)
-    {
-        window->config._width = window->internal._event.xconfigure.width;
-        window->config._height = window->internal._event.xconfigure.height;
-        if (window->event._framebuffer_size_callback)
+        std::vector<INTERNAL_monitor> &_monitors = window->internal._monitors;
+        std::vector<monitor> &_info = window->internal._monitor_info;
+        _monitors.clear();
+        _info.clear();
+
+        if (!window->internal._randr)
         {
-            window->event._framebuffer_size_callback(window, window->internal._event.xconfigure.width, window->internal._event.xconfigure.height);
+            return;
         }
-    }
 
-    static void handle_mouse_event(window *window)
-    {
-        if (window->event._mouse_callback)
+        Display *_display = window->internal._display;
+        Window _root = RootWindow(_display, window->internal._screen);
+
+        XRRScreenResources *_resources = XRRGetScreenResourcesCurrent(_display, _root);
+        if (!_resources)
         {
-            window->event._mouse_callback(window->internal._event.xbutton.button, window->internal._event.xbutton.type, window->internal._event.xbutton.state);
+            return;
         }
-    }
 
-	static void handle_key_event(window *window)
-	{
-		if (window->internal._event.xkey.keycode < 256)
-		{
-            		window->config._key_state[window->internal._event.xkey.keycode] = window->internal._event.xkey.type == KeyPress;
-        	}
+        RROutput _primary = XRRGetOutputPrimary(_display, _root);
 
-		if (window->event._key_callback)
-		{
-			window->event._key_callback(window->internal._event.xkey.keycode, window->internal._event.xkey.keycode, (window->internal._event.xkey.type) ? KEY_PRESS : KEY_RELEASE, window->internal._event.xkey.state);
-		}
-    	}
+        for (int i = 0; i < _resources->noutput; i++)
+        {
+            XRROutputInfo *_output = XRRGetOutputInfo(_display, _resources, _resources->outputs[i]);
+            if (!_output)
+            {
+                continue;
+            }
 
-	void INTERNAL_poll_events(window *window)
-	{
-		XNextEvent(window->internal._display, &window->internal._event);
+            if (_output->connection != RR_Connected || !_output->crtc)
+            {
+                XRRFreeOutputInfo(_output);
+                continue;
+            }
 
-		switch (window->internal._event.type)
-		{
-		case ClientMessage:
-			handle_client_message(window);
-			break;
-		case ConfigureNotify:
-			handle_configure_notify(window);
-			break;
-		case ButtonPress:
-		case ButtonRelease:
-			handle_mouse_event(window);
-			break;
-		case KeyPress:
-		case KeyRelease:
-			handle_key_event(window);
-			break;
-		}
+            XRRCrtcInfo *_crtc = XRRGetCrtcInfo(_display, _resources, _output->crtc);
+            if (_crtc)
+            {
+                INTERNAL_monitor _monitor = {_resources->outputs[i], _output->crtc, _crtc->mode, _crtc->x, _crtc->y, static_cast<int>(_crtc->width), static_cast<int>(_crtc->height)};
 
-	    	/*
-		Display *display = window->internal._display;
-		XEvent event = window->internal._event;
+                monitor _public = {};
+                snprintf(_public.name, sizeof(_public.name), "%.*s", _output->nameLen, _output->name);
+                _public.id = _resources->outputs[i];
+                _public.x = _crtc->x;
+                _public.y = _crtc->y;
+                _public.width = static_cast<int>(_crtc->width);
+                _public.height = static_cast<int>(_crtc->height);
+                _public.width_mm = static_cast<int>(_output->mm_width);
+                _public.height_mm = static_cast<int>(_output->mm_height);
+                _public.primary = _resources->outputs[i] == _primary;
 
-		while (XPending(display) > 0)
-		{
-			XNextEvent(display, &event);
+                if (const XRRModeInfo *_mode = find_mode(_resources, _crtc->mode))
+                {
+                    _public.refresh_rate = mode_refresh_rate(*_mode);
+                }
 
-			switch (event.type)
-			{
-			case ClientMessage:
-				handle_client_message(window, &event);
-				break;
-                	case ConfigureNotify:
-                    		handle_configure_notify(window, &event.xconfigure);
-                    		break;
-                	case ButtonPress:
-                	case ButtonRelease:
-                    		handle_mouse_event(window, &event.xbutton);
-                    		break;
-                	case KeyPress:
-                	case KeyRelease:
-                    		handle_key_event(window, &event.xkey);
-                    		break;
-            		}
-		}
-		*/
-    	}
+                if (_public.primary)
+                {
+                    _monitors.insert(_monitors.begin(), _monitor);
+                    _info.insert(_info.begin(), _public);
+                }
+                else
+                {
+                    _monitors.push_back(_monitor);
+                    _info.push_back(_public);
+                }
 
-    int INTERNAL_make_context_current(window *window)
-    {
-        if (!glXMakeCurrent(window->internal._display, window->internal._handle, window->internal._gl_context))
+                XRRFreeCrtcInfo(_crtc);
+            }
+
+            XRRFreeOutputInfo(_output);
+        }
+
+        XRRFreeScreenResources(_resources);
+        window->internal._monitors_valid = true;
+    }
+
+    const monitor *INTERNAL_get_monitors(window *window, int *count)
+    {
+        if (window->internal._backend != BACKEND_X11)
+        {
+            *count = 0;
+            return nullptr;
+        }
+
+        update_monitors(window);
+
+        *count = static_cast<int>(window->internal._monitor_info.size());
+        return window->internal._monitor_info.data();
+    }
+
+    int INTERNAL_get_window_monitor(window *window)
+    {
+        if (window->internal._backend != BACKEND_X11)
+        {
+            return MONITOR_NONE;
+        }
+
+        update_monitors(window);
+
+        // Reparented windows get positions relative to the frame, so the root position is asked once and then kept
+        if (!window->internal._position_valid)
+        {
+            Window _child;
+            XTranslateCoordinates(window->internal._display, window->internal._handle, RootWindow(window->internal._display, window->internal._screen), 0, 0, &window->internal._root_x, &window->internal._root_y, &_child);
+            window->internal._position_valid = true;
+        }
+
+        int _left = window->internal._root_x;
+        int _top = window->internal._root_y;
+        int _right = _left + window->config._width;
+        int _bottom = _top + window->config._height;
+
+        int _best = MONITOR_NONE;
+        long _best_area = 0;
+
+        for (size_t i = 0; i < window->internal._monitors.size(); i++)
+        {
+            const INTERNAL_monitor &_monitor = window->internal._monitors[i];
+
+            long _width = std::min(_right, _monitor._x + _monitor._width) - std::max(_left, _monitor._x);
+            long _height = std::min(_bottom, _monitor._y + _monitor._height) - std::max(_top, _monitor._y);
+
+            if (_width > 0 && _height > 0 && _width * _height > _best_area)
+            {
+                _best = static_cast<int>(i);
+                _best_area = _width * _height;
+            }
+        }
+
+        return _best;
+    }
+
+    // The error of the requests sent while `trap_error` is the handler. The default one exits on any error
+    static int _trapped_error = Success;
+
+    static int trap_error(Display *display, XErrorEvent *event)
+    {
+        _trapped_error = event->error_code;
+        return 0;
+    }
+
+    // Sends requests that can fail without the window being at fault, like a CRTC configuration that doesn't fit the
+    // screen or a property written on a requestor that's gone
+    template <typename request>
+    static bool send_trapped(Display *display, request send)
+    {
+        _trapped_error = Success;
+        XErrorHandler _previous = XSetErrorHandler(trap_error);
+
+        bool _sent = send();
+        XSync(display, False);
+
+        XSetErrorHandler(_previous);
+        return _sent && _trapped_error == Success;
+    }
+
+    // The CRTCs must stay inside the screen, so a mode bigger than the old one can need a bigger screen.
+    // It's grown up to the maximum of XRandR, and shrunk back by `restore_video_mode`
+    static bool fit_screen(window *window, const XRRCrtcInfo *crtc, const XRRModeInfo &mode)
+    {
+        Display *_display = window->internal._display;
+        int _screen = window->internal._screen;
+
+        bool _rotated = crtc->rotation & (RR_Rotate_90 | RR_Rotate_270);
+        int _width = crtc->x + static_cast<int>(_rotated ? mode.height : mode.width);
+        int _height = crtc->y + static_cast<int>(_rotated ? mode.width : mode.height);
+
+        int _screen_width = DisplayWidth(_display, _screen);
+        int _screen_height = DisplayHeight(_display, _screen);
+        if (_width <= _screen_width && _height <= _screen_height)
+        {
+            return true;
+        }
+
+        int _minimum_width, _minimum_height, _maximum_width, _maximum_height;
+        if (!XRRGetScreenSizeRange(_display, RootWindow(_display, _screen), &_minimum_width, &_minimum_height, &_maximum_width, &_maximum_height) ||
+            _width > _maximum_width || _height > _maximum_height)
+        {
+            Log::error("PCFW Internal: The screen can't grow to %dx%d for the mode", _width, _height);
+            return false;
+        }
+
+        _width = std::max(_width, _screen_width);
+        _height = std::max(_height, _screen_height);
+
+        // The millimeters grow with the pixels, so the DPI stays the same
+        int _mm_width = DisplayWidthMM(_display, _screen);
+        int _mm_height = DisplayHeightMM(_display, _screen);
+
+        if (!send_trapped(_display, [&] {
+                XRRSetScreenSize(_display, RootWindow(_display, _screen), _width, _height, _mm_width * _width / _screen_width, _mm_height * _height / _screen_height);
+                return true;
+            }))
+        {
+            Log::error("PCFW Internal: Failed to grow the screen to %dx%d for the mode", _width, _height);
+            return false;
+        }
+
+        // Only the size before the first switch is remembered, like the mode
+        if (!window->internal._original_screen_width)
+        {
+            window->internal._original_screen_width = _screen_width;
+            window->internal._original_screen_height = _screen_height;
+            window->internal._original_screen_mm_width = _mm_width;
+            window->internal._original_screen_mm_height = _mm_height;
+        }
+
+        return true;
+    }
+
+    static int set_video_mode(window *window, INTERNAL_monitor &monitor, int width, int height, double refresh_rate)
+    {
+        Display *_display = window->internal._display;
+
+        XRRScreenResources *_resources = XRRGetScreenResourcesCurrent(_display, RootWindow(_display, window->internal._screen));
+        if (!_resources)
+        {
+            Log::error("PCFW Internal: Failed to get the screen resources");
+            return 1;
+        }
+
+        XRROutputInfo *_output = XRRGetOutputInfo(_display, _resources, monitor._output);
+        XRRCrtcInfo *_crtc = XRRGetCrtcInfo(_display, _resources, monitor._crtc);
+
+        // The mode with that size and the nearest refresh rate, or the highest one
+        const XRRModeInfo *_best = nullptr;
+        double _best_difference = 0.0;
+
+        for (int i = 0; _output && i < _output->nmode; i++)
+        {
+            const XRRModeInfo *_mode = find_mode(_resources, _output->modes[i]);
+            if (!_mode || static_cast<int>(_mode->width) != width || static_cast<int>(_mode->height) != height || (_mode->modeFlags & RR_Interlace))
+            {
+                continue;
+            }
+
+            double _difference = refresh_rate > 0.0 ? std::abs(mode_refresh_rate(*_mode) - refresh_rate) : -mode_refresh_rate(*_mode);
+            if (!_best || _difference < _best_difference)
+            {
+                _best = _mode;
+                _best_difference = _difference;
+            }
+        }
+
+        int _result = 1;
+
+        if (!_best || !_crtc)
+        {
+            Log::error("PCFW Internal: The monitor has no %dx%d mode", width, height);
+        }
+        else
+        {
+            // Only the first switch is remembered, it's the mode to go back to
+            if (!window->internal._mode_crtc)
+            {
+                window->internal._mode_crtc = monitor._crtc;
+                window->internal._original_mode = _crtc->mode;
+            }
+
+            bool _switched = fit_screen(window, _crtc, *_best) && send_trapped(_display, [&] {
+                return XRRSetCrtcConfig(_display, _resources, monitor._crtc, CurrentTime, _crtc->x, _crtc->y, _best->id, _crtc->rotation, _crtc->outputs, _crtc->noutput) == Success;
+            });
+
+            if (_switched)
+            {
+                monitor._mode = _best->id;
+                monitor._width = width;
+                monitor._height = height;
+                window->internal._monitors_valid = false;
+                _result = 0;
+            }
+            else
+            {
+                Log::error("PCFW Internal: Failed to switch the video mode");
+            }
+        }
+
+        if (_crtc)
+        {
+            XRRFreeCrtcInfo(_crtc);
+        }
+
+        if (_output)
+        {
+            XRRFreeOutputInfo(_output);
+        }
+
+        XRRFreeScreenResources(_resources);
+        return _result;
+    }
+
+    static void restore_video_mode(window *window)
+    {
+        if (!window->internal._mode_crtc)
+        {
+            return;
+        }
+
+        Display *_display = window->internal._display;
+
+        XRRScreenResources *_resources = XRRGetScreenResourcesCurrent(_display, RootWindow(_display, window->internal._screen));
+        if (_resources)
+        {
+            XRRCrtcInfo *_crtc = XRRGetCrtcInfo(_display, _resources, window->internal._mode_crtc);
+            if (_crtc)
+            {
+                send_trapped(_display, [&] {
+                    return XRRSetCrtcConfig(_display, _resources, window->internal._mode_crtc, CurrentTime, _crtc->x, _crtc->y, window->internal._original_mode, _crtc->rotation, _crtc->outputs, _crtc->noutput) == Success;
+                });
+                XRRFreeCrtcInfo(_crtc);
+            }
+
+            XRRFreeScreenResources(_resources);
+        }
+
+        // Shrinking fails if another CRTC was moved into the grown part meanwhile, the screen stays big then
+        if (window->internal._original_screen_width)
+        {
+            send_trapped(_display, [&] {
+                XRRSetScreenSize(_display, RootWindow(_display, window->internal._screen), window->internal._original_screen_width, window->internal._original_screen_height,
+                                 window->internal._original_screen_mm_width, window->internal._original_screen_mm_height);
+                return true;
+            });
+        }
+
+        window->internal._mode_crtc = None;
+        window->internal._original_mode = None;
+        window->internal._original_screen_width = 0;
+        window->internal._original_screen_height = 0;
+        window->internal._monitors_valid = false;
+    }
+
+    // Asks the window manager to add (`1`) or remove (`0`) a state of the window
+    static void send_wm_state(window *window, long action, Atom state)
+    {
+        XEvent _event = {};
+        _event.xclient.type = ClientMessage;
+        _event.xclient.window = window->internal._handle;
+        _event.xclient.message_type = window->internal._atoms[ATOM_NET_WM_STATE];
+        _event.xclient.format = 32;
+        _event.xclient.data.l[0] = action;
+        _event.xclient.data.l[1] = static_cast<long>(state);
+        _event.xclient.data.l[2] = 0;
+        _event.xclient.data.l[3] = 1;
+
+        XSendEvent(window->internal._display, RootWindow(window->internal._display, window->internal._screen), False, SubstructureNotifyMask | SubstructureRedirectMask, &_event);
+    }
+
+    // The left and top sizes of the decorations of the window manager, `0` without one that tells them
+    static void get_frame_extents(window *window, int *left, int *top)
+    {
+        Atom _type;
+        int _format;
+        unsigned long _count, _after;
+        unsigned char *_data = nullptr;
+
+        *left = 0;
+        *top = 0;
+
+        // Left, right, top and bottom. Format 32 comes as longs
+        if (XGetWindowProperty(window->internal._display, window->internal._handle, window->internal._atoms[ATOM_NET_FRAME_EXTENTS], 0, 4, False, XA_CARDINAL, &_type, &_format, &_count, &_after, &_data) == Success && _data && _count == 4)
+        {
+            const long *_extents = reinterpret_cast<const long *>(_data);
+            *left = static_cast<int>(_extents[0]);
+            *top = static_cast<int>(_extents[2]);
+        }
+
+        if (_data)
+        {
+            XFree(_data);
+        }
+    }
+
+    int INTERNAL_set_window_fullscreen(window *window, int monitor, int width, int height, double refresh_rate)
+    {
+        if (window->internal._backend != BACKEND_X11)
+        {
+            Log::error("PCFW Internal: Fullscreen is only supported by the X11 backend");
+            return 1;
+        }
+
+        Display *_display = window->internal._display;
+        Window _handle = window->internal._handle;
+
+        // Going back to windowed
+        if (monitor < 0)
+        {
+            if (!window->internal._fullscreen)
+            {
+                return 0;
+            }
+
+            restore_video_mode(window);
+            send_wm_state(window, 0, window->internal._atoms[ATOM_NET_WM_STATE_FULLSCREEN]);
+            XDeleteProperty(_display, _handle, window->internal._atoms[ATOM_NET_WM_BYPASS_COMPOSITOR]);
+            XMoveResizeWindow(_display, _handle, window->internal._windowed_x, window->internal._windowed_y, window->internal._windowed_width, window->internal._windowed_height);
+            XFlush(_display);
+
+            window->internal._fullscreen = false;
+            return 0;
+        }
+
+        update_monitors(window);
+
+        if (monitor >= static_cast<int>(window->internal._monitors.size()))
+        {
+            Log::error("PCFW Internal: No monitor %d", monitor);
+            return 1;
+        }
+
+        // A copy, the video mode switch makes XRandR invalidate the cache
+        INTERNAL_monitor _monitor = window->internal._monitors[monitor];
+
+        if (!window->internal._fullscreen)
+        {
+            Window _child;
+            XWindowAttributes _attributes;
+            XGetWindowAttributes(_display, _handle, &_attributes);
+            XTranslateCoordinates(_display, _handle, _attributes.root, 0, 0, &window->internal._windowed_x, &window->internal._windowed_y, &_child);
+
+            // `XMoveResizeWindow` places the frame of the window manager, so that's the position to go back to
+            int _left, _top;
+            get_frame_extents(window, &_left, &_top);
+            window->internal._windowed_x -= _left;
+            window->internal._windowed_y -= _top;
+
+            window->internal._windowed_width = _attributes.width;
+            window->internal._windowed_height = _attributes.height;
+        }
+
+        // A mode switched on another monitor is given back first
+        if (window->internal._mode_crtc && window->internal._mode_crtc != _monitor._crtc)
+        {
+            restore_video_mode(window);
+        }
+
+        if (width > 0 && height > 0 && set_video_mode(window, _monitor, width, height, refresh_rate))
+        {
+            return 1;
+        }
+
+        // The window manager makes fullscreen on the monitor that has the window
+        XMoveResizeWindow(_display, _handle, _monitor._x, _monitor._y, _monitor._width, _monitor._height);
+
+        // Compositors unredirect the window, so its frames are scanned out without a copy
+        long _bypass = 1;
+        XChangeProperty(_display, _handle, window->internal._atoms[ATOM_NET_WM_BYPASS_COMPOSITOR], XA_CARDINAL, 32, PropModeReplace, reinterpret_cast<unsigned char *>(&_bypass), 1);
+
+        send_wm_state(window, 1, window->internal._atoms[ATOM_NET_WM_STATE_FULLSCREEN]);
+        XFlush(_display);
+
+        window->internal._fullscreen = true;
+        return 0;
+    }
+
+    int INTERNAL_destroy_window(window *window)
+    {
+        if (window->internal._wake_fd >= 0)
+        {
+            close(window->internal._wake_fd);
+            window->internal._wake_fd = -1;
+        }
+
+#ifdef PCFW_WAYLAND
+        if (window->internal._backend == BACKEND_WAYLAND)
+        {
+            return WAYLAND_destroy_window(window);
+        }
+#endif
+
+        restore_video_mode(window);
+
+        if (window->internal._sync_counter)
+        {
+            XSyncDestroyCounter(window->internal._display, window->internal._sync_counter);
+        }
+
+        if (window->internal._gl_context)
+        {
+            glXMakeCurrent(window->internal._display, None, nullptr);
+            glXDestroyContext(window->internal._display, window->internal._gl_context);
+        }
+
+        if (window->internal._handle)
+        {
+            XDestroyWindow(window->internal._display, window->internal._handle);
+        }
+
+        // The colormap is the one given to `XCreateWindow`
+        if (window->internal._attributes.colormap)
+        {
+            XFreeColormap(window->internal._display, window->internal._attributes.colormap);
+        }
+
+        if (window->internal._visual_info)
+        {
+            XFree(window->internal._visual_info);
+        }
+
+        if (window->internal._display)
+        {
+            XCloseDisplay(window->internal._display);
+        }
+
+        return 0;
+    }
+
+    bool INTERNAL_window_should_close(window *window)
+    {
+        return window ? window->config._should_close : false;
+    }
+
+    static void handle_client_message(window *window)
+    {
+        const XClientMessageEvent &_message = window->internal._event.xclient;
+
+        // The window manager will resize the window, and waits for the counter before the next resize
+        if (static_cast<Atom>(_message.data.l[0]) == window->internal._atoms[ATOM_NET_WM_SYNC_REQUEST] && window->internal._sync_counter)
+        {
+            XSyncIntsToValue(&window->internal._sync_value, static_cast<unsigned int>(_message.data.l[2]), static_cast<int>(_message.data.l[3]));
+            window->internal._sync_requested = true;
+            window->internal._sync_configured = false;
+            return;
+        }
+
+        if (static_cast<Atom>(_message.data.l[0]) == window->internal._atoms[ATOM_WM_DELETE_WINDOW])
+        {
+            window->config._should_close = true;
+
+            event _event = {};
+            _event.type = EVENT_CLOSE;
+            INTERNAL_post_event(window, _event);
+        }
+    }
+
+    static void handle_configure_notify(window *window)
+    {
+        PCFW_TRACE_SCOPE("configure_notify");
+
+        // Only the events sent by the window manager have the position on the root window
+        window->internal._position_valid = window->internal._event.xconfigure.send_event;
+        window->internal._root_x = window->internal._event.xconfigure.x;
+        window->internal._root_y = window->internal._event.xconfigure.y;
+
+        bool _resized = window->config._width != window->internal._event.xconfigure.width || window->config._height != window->internal._event.xconfigure.height;
+
+        window->config._width = window->internal._event.xconfigure.width;
+        window->config._height = window->internal._event.xconfigure.height;
+        if (window->event._framebuffer_size_callback)
+        {
+            window->event._framebuffer_size_callback(window, window->internal._event.xconfigure.width, window->internal._event.xconfigure.height);
+        }
+
+        // The next swap has the size the window manager asked for
+        if (window->internal._sync_requested)
+        {
+            window->internal._sync_configured = true;
+        }
+
+        // Redrawing now, the loop may be blocked by the resize
+        if (_resized && window->event._refresh_callback)
+        {
+            window->event._refresh_callback(window);
+        }
+
+        event _event = {};
+        _event.type = EVENT_RESIZE;
+        _event.width = window->config._width;
+        _event.height = window->config._height;
+        INTERNAL_post_event(window, _event);
+    }
+
+    static void handle_mouse_event(window *window)
+    {
+        PCFW_TRACE_SCOPE("mouse_event");
+
+        if (window->event._mouse_callback)
+        {
+            window->event._mouse_callback(window->internal._event.xbutton.button, window->internal._event.xbutton.type, window->internal._event.xbutton.state);
+        }
+
+        event _event = {};
+        _event.type = EVENT_MOUSE_BUTTON;
+        _event.button = window->internal._event.xbutton.button;
+        _event.status = window->internal._event.xbutton.type;
+        _event.mods = window->internal._event.xbutton.state;
+        INTERNAL_post_event(window, _event);
+    }
+
+    static void handle_motion_event(window *window)
+    {
+        event _event = {};
+        _event.type = EVENT_MOUSE_MOTION;
+        _event.x = window->internal._event.xmotion.x;
+        _event.y = window->internal._event.xmotion.y;
+        _event.mods = window->internal._event.xmotion.state;
+        INTERNAL_post_event(window, _event);
+    }
+
+    static void handle_crossing_event(window *window)
+    {
+        event _event = {};
+        _event.type = EVENT_ENTER_LEAVE;
+        _event.x = window->internal._event.xcrossing.x;
+        _event.y = window->internal._event.xcrossing.y;
+        _event.mods = window->internal._event.xcrossing.state;
+        _event.active = window->internal._event.type == EnterNotify;
+        INTERNAL_post_event(window, _event);
+    }
+
+    static void handle_focus_event(window *window)
+    {
+        // Keyboard grabs move the focus for a moment without the window really losing it
+        if (window->internal._event.xfocus.mode == NotifyGrab || window->internal._event.xfocus.mode == NotifyUngrab)
+        {
+            return;
+        }
+
+        event _event = {};
+        _event.type = EVENT_FOCUS;
+        _event.active = window->internal._event.type == FocusIn;
+        INTERNAL_post_event(window, _event);
+    }
+
+	static void handle_key_event(window *window)
+	{
+		PCFW_TRACE_SCOPE("key_event");
+
+		if (window->internal._event.xkey.keycode < 256)
+		{
+            		window->config._key_state[window->internal._event.xkey.keycode] = window->internal._event.xkey.type == KeyPress;
+        	}
+
+		if (window->event._key_callback)
+		{
+			window->event._key_callback(window->internal._event.xkey.keycode, window->internal._event.xkey.keycode, (window->internal._event.xkey.type) ? KEY_PRESS : KEY_RELEASE, window->internal._event.xkey.state);
+		}
+
+		event _event = {};
+		_event.type = EVENT_KEY;
+		_event.key = window->internal._event.xkey.keycode;
+		_event.scancode = window->internal._event.xkey.keycode;
+		_event.action = window->internal._event.xkey.type == KeyPress ? KEY_PRESS : KEY_RELEASE;
+		_event.mods = window->internal._event.xkey.state;
+		INTERNAL_post_event(window, _event);
+    	}
+
+    // Clipboard
+
+    static Atom intern_atom(window *window, const char *name)
+    {
+        xcb_intern_atom_reply_t *_reply = xcb_intern_atom_reply(window->internal._connection, xcb_intern_atom(window->internal._connection, 0, strlen(name), name), nullptr);
+        if (!_reply)
+        {
+            return None;
+        }
+
+        Atom _atom = _reply->atom;
+        free(_reply);
+        return _atom;
+    }
+
+    static long long monotonic_time()
+    {
+        timespec _time;
+        clock_gettime(CLOCK_MONOTONIC, &_time);
+        return _time.tv_sec * 1000000000LL + _time.tv_nsec;
+    }
+
+    // How long the other side of a clipboard transfer can take to send or ask for the next chunk
+    constexpr long long CLIPBOARD_TRANSFER_TIMEOUT = 5000000000LL;
+
+    // The largest chunk sent with a single `XChangeProperty`. Larger clipboards use INCR
+    static size_t clipboard_chunk_size(Display *display)
+    {
+        long _maximum = XExtendedMaxRequestSize(display);
+        if (_maximum == 0)
+        {
+            _maximum = XMaxRequestSize(display);
+        }
+
+        size_t _size = static_cast<size_t>(_maximum) * 4 - 1024;
+        return _size < 262144 ? _size : 262144;
+    }
+
+    // Sizes in memory of the items of a property
+    static size_t property_size(int format, unsigned long count)
+    {
+        switch (format)
+        {
+        case 16:
+            return count * sizeof(short);
+        case 32:
+            return count * sizeof(long);
+        default:
+            return count;
+        }
+    }
+
+    static void finish_clipboard_request(window *window, int status)
+    {
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+        clipboard_callback _callback = _clipboard._callback;
+
+        _clipboard._callback = nullptr;
+        _clipboard._incremental = false;
+
+        _callback(window, nullptr, 0, status, _clipboard._user_data);
+    }
+
+    // A requestor can receive several transfers at once. Its events are selected while one of them is left
+    static bool has_transfers(const INTERNAL_clipboard &clipboard, Window requestor)
+    {
+        for (const INTERNAL_clipboard_transfer &_transfer : clipboard._transfers)
+        {
+            if (_transfer._requestor == requestor)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // The requestor may be destroyed before its DestroyNotify is read, so the errors are trapped
+    static void release_requestor(window *window, Window requestor)
+    {
+        Display *_display = window->internal._display;
+
+        if (!has_transfers(window->internal._clipboard, requestor))
+        {
+            send_trapped(_display, [&] {
+                XSelectInput(_display, requestor, NoEventMask);
+                return true;
+            });
+        }
+    }
+
+    static void drop_transfer(window *window, size_t index)
+    {
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+        Window _requestor = _clipboard._transfers[index]._requestor;
+
+        _clipboard._transfers.erase(_clipboard._transfers.begin() + index);
+        release_requestor(window, _requestor);
+    }
+
+    static void handle_requestor_destroyed(window *window)
+    {
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+        Window _requestor = window->internal._event.xdestroywindow.window;
+
+        for (size_t i = _clipboard._transfers.size(); i-- > 0;)
+        {
+            if (_clipboard._transfers[i]._requestor == _requestor)
+            {
+                _clipboard._transfers.erase(_clipboard._transfers.begin() + i);
+            }
+        }
+    }
+
+    static void drop_stalled_transfers(window *window)
+    {
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+        long long _now = monotonic_time();
+
+        for (size_t i = _clipboard._transfers.size(); i-- > 0;)
+        {
+            if (_now - _clipboard._transfers[i]._time > CLIPBOARD_TRANSFER_TIMEOUT)
+            {
+                Log::warning("PCFW Internal: Dropping a clipboard transfer, the requestor stopped taking chunks");
+                drop_transfer(window, i);
+            }
+        }
+    }
+
+    static void fail_stalled_request(window *window)
+    {
+        if (monotonic_time() - window->internal._clipboard._time > CLIPBOARD_TRANSFER_TIMEOUT)
+        {
+            Log::warning("PCFW Internal: The clipboard owner stopped sending, the request failed");
+            finish_clipboard_request(window, CLIPBOARD_FAILED);
+        }
+    }
+
+    static void handle_selection_request(window *window)
+    {
+        PCFW_TRACE_SCOPE("selection_request");
+
+        const XSelectionRequestEvent &_request = window->internal._event.xselectionrequest;
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+        Display *_display = window->internal._display;
+
+        XEvent _reply = {};
+        _reply.xselection.type = SelectionNotify;
+        _reply.xselection.requestor = _request.requestor;
+        _reply.xselection.selection = _request.selection;
+        _reply.xselection.target = _request.target;
+        _reply.xselection.time = _request.time;
+        _reply.xselection.property = None;
+
+        // Obsolete clients give no property
+        Atom _property = _request.property != None ? _request.property : _request.target;
+
+        if (_clipboard._data && _request.target == window->internal._atoms[ATOM_TARGETS])
+        {
+            Atom _targets[] = {window->internal._atoms[ATOM_TARGETS], _clipboard._type};
+            bool _written = send_trapped(_display, [&] {
+                XChangeProperty(_display, _request.requestor, _property, XA_ATOM, 32, PropModeReplace, reinterpret_cast<unsigned char *>(_targets), 2);
+                return true;
+            });
+
+            // A requestor that's gone has nothing to reply to
+            if (!_written)
+            {
+                return;
+            }
+
+            _reply.xselection.property = _property;
+        }
+        else if (_clipboard._data && _request.target == _clipboard._type)
+        {
+            const std::vector<unsigned char> &_data = *_clipboard._data;
+
+            if (_data.size() <= clipboard_chunk_size(_display))
+            {
+                bool _written = send_trapped(_display, [&] {
+                    XChangeProperty(_display, _request.requestor, _property, _clipboard._type, 8, PropModeReplace, _data.data(), static_cast<int>(_data.size()));
+                    return true;
+                });
+
+                if (!_written)
+                {
+                    return;
+                }
+            }
+            else
+            {
+                // The chunks are sent each time the requestor deletes the property, and the transfer is dropped if it's destroyed
+                long _size = static_cast<long>(_data.size());
+                bool _started = send_trapped(_display, [&] {
+                    XSelectInput(_display, _request.requestor, PropertyChangeMask | StructureNotifyMask);
+                    XChangeProperty(_display, _request.requestor, _property, window->internal._atoms[ATOM_INCR], 32, PropModeReplace, reinterpret_cast<unsigned char *>(&_size), 1);
+                    return true;
+                });
+
+                if (!_started)
+                {
+                    // Gone already, there's nothing to reply to
+                    release_requestor(window, _request.requestor);
+                    return;
+                }
+
+                _clipboard._transfers.push_back({_request.requestor, _property, _clipboard._type, _clipboard._data, 0, false, monotonic_time()});
+            }
+
+            _reply.xselection.property = _property;
+        }
+
+        send_trapped(_display, [&] {
+            return XSendEvent(_display, _request.requestor, False, NoEventMask, &_reply) != 0;
+        });
+    }
+
+    static void handle_selection_clear(window *window)
+    {
+        if (window->internal._event.xselectionclear.selection == window->internal._atoms[ATOM_CLIPBOARD])
+        {
+            window->internal._clipboard._data.reset();
+        }
+    }
+
+    static void read_clipboard_property(window *window)
+    {
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+        _clipboard._time = monotonic_time();
+
+        Atom _type;
+        int _format;
+        unsigned long _count, _after;
+        unsigned char *_data = nullptr;
+
+        // Deleting the property asks the owner for the next chunk
+        if (XGetWindowProperty(window->internal._display, window->internal._handle, window->internal._atoms[ATOM_PCFW_SELECTION], 0, LONG_MAX / 4, True, AnyPropertyType, &_type, &_format, &_count, &_after, &_data) != Success)
+        {
+            finish_clipboard_request(window, CLIPBOARD_FAILED);
+            return;
+        }
+
+        if (_type == window->internal._atoms[ATOM_INCR])
+        {
+            _clipboard._incremental = true;
+        }
+        else if (_count > 0)
+        {
+            _clipboard._callback(window, _data, property_size(_format, _count), CLIPBOARD_DATA, _clipboard._user_data);
+        }
+
+        if (_data)
+        {
+            XFree(_data);
+        }
+
+        // A single property, or the empty chunk that ends an INCR transfer
+        if (_type != window->internal._atoms[ATOM_INCR] && (!_clipboard._incremental || _count == 0))
+        {
+            finish_clipboard_request(window, CLIPBOARD_DONE);
+        }
+    }
+
+    static void handle_selection_notify(window *window)
+    {
+        PCFW_TRACE_SCOPE("selection_notify");
+
+        if (!window->internal._clipboard._callback || window->internal._event.xselection.selection != window->internal._atoms[ATOM_CLIPBOARD])
+        {
+            return;
+        }
+
+        if (window->internal._event.xselection.property == None)
+        {
+            finish_clipboard_request(window, CLIPBOARD_FAILED);
+            return;
+        }
+
+        read_clipboard_property(window);
+    }
+
+    // Changes what the visibility is made of. A window seen again is redrawn, what it showed may be gone
+    static void set_visibility(window *window, bool mapped, bool minimized, bool obscured)
+    {
+        int _before = INTERNAL_get_window_visibility(window);
+
+        window->internal._mapped = mapped;
+        window->internal._minimized = minimized;
+        window->internal._obscured = obscured;
+
+        if (_before != VISIBILITY_VISIBLE && INTERNAL_get_window_visibility(window) == VISIBILITY_VISIBLE)
+        {
+            window->event._redraw = true;
+        }
+    }
+
+    // Window managers that keep minimized windows mapped only say it in `_NET_WM_STATE`
+    static void update_minimized(window *window)
+    {
+        Atom _type;
+        int _format;
+        unsigned long _count, _after;
+        unsigned char *_data = nullptr;
+
+        bool _minimized = false;
+
+        if (XGetWindowProperty(window->internal._display, window->internal._handle, window->internal._atoms[ATOM_NET_WM_STATE], 0, 64, False, XA_ATOM, &_type, &_format, &_count, &_after, &_data) == Success && _data)
+        {
+            // Format 32 comes as longs
+            const Atom *_states = reinterpret_cast<const Atom *>(_data);
+            for (unsigned long i = 0; i < _count; i++)
+            {
+                if (_states[i] == window->internal._atoms[ATOM_NET_WM_STATE_HIDDEN])
+                {
+                    _minimized = true;
+                }
+            }
+        }
+
+        if (_data)
+        {
+            XFree(_data);
+        }
+
+        set_visibility(window, window->internal._mapped, _minimized, window->internal._obscured);
+    }
+
+    static void handle_property_notify(window *window)
+    {
+        PCFW_TRACE_SCOPE("property_notify");
+
+        const XPropertyEvent &_event = window->internal._event.xproperty;
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+
+        if (_event.window == window->internal._handle && _event.atom == window->internal._atoms[ATOM_NET_WM_STATE])
+        {
+            update_minimized(window);
+            return;
+        }
+
+        // A chunk arrived
+        if (_event.window == window->internal._handle)
+        {
+            if (_clipboard._callback && _clipboard._incremental && _event.atom == window->internal._atoms[ATOM_PCFW_SELECTION] && _event.state == PropertyNewValue)
+            {
+                read_clipboard_property(window);
+            }
+            return;
+        }
+
+        // A requestor took a chunk
+        if (_event.state != PropertyDelete)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < _clipboard._transfers.size(); i++)
+        {
+            INTERNAL_clipboard_transfer &_transfer = _clipboard._transfers[i];
+            if (_transfer._requestor != _event.window || _transfer._property != _event.atom)
+            {
+                continue;
+            }
+
+            if (_transfer._finished)
+            {
+                drop_transfer(window, i);
+                return;
+            }
+
+            Display *_display = window->internal._display;
+            size_t _remaining = _transfer._data->size() - _transfer._offset;
+            size_t _size = std::min(_remaining, clipboard_chunk_size(_display));
+
+            bool _sent = send_trapped(_display, [&] {
+                XChangeProperty(_display, _transfer._requestor, _transfer._property, _transfer._type, 8, PropModeReplace, _transfer._data->data() + _transfer._offset, static_cast<int>(_size));
+                return true;
+            });
+
+            if (!_sent)
+            {
+                drop_transfer(window, i);
+                return;
+            }
+
+            _transfer._offset += _size;
+            _transfer._finished = _size == 0;
+            _transfer._time = monotonic_time();
+            return;
+        }
+    }
+
+    int INTERNAL_set_clipboard(window *window, const char *type, const void *data, size_t size)
+    {
+        if (window->internal._backend != BACKEND_X11)
+        {
+            Log::error("PCFW Internal: The clipboard is only supported by the X11 backend");
+            return 1;
+        }
+
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+
+        _clipboard._type = type ? intern_atom(window, type) : window->internal._atoms[ATOM_UTF8_STRING];
+        if (_clipboard._type == None)
+        {
+            Log::error("PCFW Internal: Failed to intern the clipboard type");
+            return 1;
+        }
+
+        const unsigned char *_bytes = static_cast<const unsigned char *>(data);
+        _clipboard._data = std::make_shared<const std::vector<unsigned char>>(_bytes, _bytes + size);
+
+        XSetSelectionOwner(window->internal._display, window->internal._atoms[ATOM_CLIPBOARD], window->internal._handle, CurrentTime);
+        if (XGetSelectionOwner(window->internal._display, window->internal._atoms[ATOM_CLIPBOARD]) != window->internal._handle)
+        {
+            Log::error("PCFW Internal: Failed to own the clipboard");
+            _clipboard._data.reset();
+            return 1;
+        }
+
+        return 0;
+    }
+
+    int INTERNAL_request_clipboard(window *window, const char *type, clipboard_callback callback, void *user_data)
+    {
+        if (window->internal._backend != BACKEND_X11)
+        {
+            Log::error("PCFW Internal: The clipboard is only supported by the X11 backend");
+            return 1;
+        }
+
+        INTERNAL_clipboard &_clipboard = window->internal._clipboard;
+
+        if (_clipboard._callback)
+        {
+            Log::warning("PCFW Internal: The window is already receiving the clipboard");
+            return 1;
+        }
+
+        Atom _type = type ? intern_atom(window, type) : window->internal._atoms[ATOM_UTF8_STRING];
+        if (_type == None)
+        {
+            Log::error("PCFW Internal: Failed to intern the clipboard type");
+            return 1;
+        }
+
+        // The window owns the clipboard, there's nothing to convert
+        if (_clipboard._data && _clipboard._type == _type && XGetSelectionOwner(window->internal._display, window->internal._atoms[ATOM_CLIPBOARD]) == window->internal._handle)
+        {
+            callback(window, _clipboard._data->data(), _clipboard._data->size(), CLIPBOARD_DATA, user_data);
+            callback(window, nullptr, 0, CLIPBOARD_DONE, user_data);
+            return 0;
+        }
+
+        _clipboard._callback = callback;
+        _clipboard._user_data = user_data;
+        _clipboard._incremental = false;
+        _clipboard._time = monotonic_time();
+
+        XConvertSelection(window->internal._display, window->internal._atoms[ATOM_CLIPBOARD], _type, window->internal._atoms[ATOM_PCFW_SELECTION], window->internal._handle, CurrentTime);
+        XFlush(window->internal._display);
+
+        return 0;
+    }
+
+	static void handle_event(window *window)
+	{
+		PCFW_TRACE_SCOPE("handle_event");
+
+		// XRandR events don't have constant types
+		if (window->internal._randr)
+		{
+			int _type = window->internal._event.type - window->internal._randr_event_base;
+
+			if (_type == RRScreenChangeNotify)
+			{
+				XRRUpdateConfiguration(&window->internal._event);
+				window->internal._monitors_valid = false;
+				return;
+			}
+
+			if (_type == RRNotify)
+			{
+				window->internal._monitors_valid = false;
+				return;
+			}
+		}
+
+		// Requestors of INCR transfers. They select StructureNotifyMask only to see them destroyed
+		if (window->internal._event.xany.window != window->internal._handle && window->internal._event.type != PropertyNotify)
+		{
+			if (window->internal._event.type == DestroyNotify)
+			{
+				handle_requestor_destroyed(window);
+			}
+			return;
+		}
+
+		switch (window->internal._event.type)
+		{
+		case SelectionRequest:
+			handle_selection_request(window);
+			break;
+		case SelectionClear:
+			handle_selection_clear(window);
+			break;
+		case SelectionNotify:
+			handle_selection_notify(window);
+			break;
+		case PropertyNotify:
+			handle_property_notify(window);
+			break;
+		case ClientMessage:
+			handle_client_message(window);
+			break;
+		case ConfigureNotify:
+			handle_configure_notify(window);
+			break;
+		case MapNotify:
+			set_visibility(window, true, window->internal._minimized, window->internal._obscured);
+			break;
+		case UnmapNotify:
+			set_visibility(window, false, window->internal._minimized, window->internal._obscured);
+			break;
+		case VisibilityNotify:
+			// Partly obscured windows still show something
+			set_visibility(window, window->internal._mapped, window->internal._minimized, window->internal._event.xvisibility.state == VisibilityFullyObscured);
+			break;
+		case Expose:
+			// Only the last of a series, the whole window is redrawn anyway
+			if (window->internal._event.xexpose.count == 0)
+			{
+				window->event._redraw = true;
+
+				if (window->event._refresh_callback)
+				{
+					window->event._refresh_callback(window);
+				}
+			}
+			break;
+		case ButtonPress:
+		case ButtonRelease:
+			handle_mouse_event(window);
+			break;
+		case KeyPress:
+		case KeyRelease:
+			handle_key_event(window);
+			break;
+		case MotionNotify:
+			handle_motion_event(window);
+			break;
+		case EnterNotify:
+		case LeaveNotify:
+			handle_crossing_event(window);
+			break;
+		case FocusIn:
+		case FocusOut:
+			handle_focus_event(window);
+			break;
+		}
+	}
+
+	// Waits up to `timeout` milliseconds for the X connection, `request_redraw` or a gamepad in a single poll, then handles everything that is ready
+	static void process_events(window *window, int timeout)
+	{
+		Display *_display = window->internal._display;
+
+		pollfd _fds[2 + GAMEPAD_FD_MAX];
+		_fds[0] = {ConnectionNumber(_display), POLLIN, 0};
+		_fds[1] = {window->internal._wake_fd, POLLIN, 0};
+		int _count = 2 + INTERNAL_gamepad_fds(_fds + 2, GAMEPAD_FD_MAX);
+
+		// Queued events mustn't wait for the socket. `XPending` also flushes the requests
+		if (XPending(_display) > 0)
+		{
+			timeout = 0;
+		}
+
+		// Without gamepads nothing needs the poll when it doesn't wait. A redraw left in the eventfd only wakes the next wait once
+		if (_count > 2 || timeout != 0)
+		{
+			poll(_fds, _count, timeout);
+		}
+
+		if (_fds[1].revents & POLLIN)
+		{
+			INTERNAL_clear_wake_fd(window->internal._wake_fd);
+		}
+
+		while (XPending(_display) > 0)
+		{
+			XNextEvent(_display, &window->internal._event);
+			handle_event(window);
+		}
+
+		INTERNAL_gamepad_process(_fds + 2, _count - 2);
+
+		if (!window->internal._clipboard._transfers.empty())
+		{
+			drop_stalled_transfers(window);
+		}
+
+		if (window->internal._clipboard._callback)
+		{
+			fail_stalled_request(window);
+		}
+
+		// Prefetching the cursor position if it was asked for in the last frame
+		if (window->internal._pointer_wanted)
+		{
+			if (window->internal._pointer_request)
+			{
+				xcb_discard_reply(window->internal._connection, window->internal._pointer_request);
+			}
+
+			window->internal._pointer_request = xcb_query_pointer(window->internal._connection, window->internal._handle).sequence;
+			window->internal._pointer_frame = window->config._frame_arenas._frame.load(std::memory_order_relaxed);
+			window->internal._pointer_wanted = false;
+			xcb_flush(window->internal._connection);
+		}
+	}
+
+	void INTERNAL_poll_events(window *window)
+	{
+		PCFW_TRACE_SCOPE("poll_events");
+
+#ifdef PCFW_WAYLAND
+		if (window->internal._backend == BACKEND_WAYLAND)
+		{
+			WAYLAND_poll_events(window);
+			return;
+		}
+#endif
+
+		process_events(window, 0);
+	}
+
+	// The first `wait_events` or `needs_redraw` tells the window is drawn on demand
+	static void use_on_demand(window *window)
+	{
+		if (!window->internal._on_demand)
+		{
+			window->internal._on_demand = true;
+			update_event_mask(window);
+		}
+	}
+
+	void INTERNAL_wait_events(window *window, int timeout)
+	{
+		PCFW_TRACE_SCOPE("wait_events");
+
+		use_on_demand(window);
+
+		// The loop has a frame to draw already
+		if (window->event._redraw)
+		{
+			timeout = 0;
+		}
+
+#ifdef PCFW_WAYLAND
+		if (window->internal._backend == BACKEND_WAYLAND)
+		{
+			WAYLAND_wait_events(window, timeout);
+			return;
+		}
+#endif
+
+		process_events(window, timeout);
+	}
+
+	int INTERNAL_needs_redraw(window *window)
+	{
+		use_on_demand(window);
+		return window->event._redraw.exchange(false);
+	}
+
+	void INTERNAL_request_redraw(window *window)
+	{
+		window->event._redraw = true;
+
+		// Nonblocking. If the counter is full the poll is awake already
+		uint64_t _value = 1;
+		ssize_t _written = write(window->internal._wake_fd, &_value, sizeof(_value));
+		(void)_written;
+	}
+
+	void INTERNAL_clear_wake_fd(int fd)
+	{
+		uint64_t _value;
+		ssize_t _read = read(fd, &_value, sizeof(_value));
+		(void)_read;
+	}
+
+	// External event loops
+
+	int INTERNAL_get_event_fd(window *window)
+	{
+#ifdef PCFW_WAYLAND
+		if (window->internal._backend == BACKEND_WAYLAND)
+		{
+			return WAYLAND_get_event_fd(window);
+		}
+#endif
+
+		return ConnectionNumber(window->internal._display);
+	}
+
+	int INTERNAL_get_event_fds(window *window, int *fds, int max)
+	{
+		pollfd _fds[2 + GAMEPAD_FD_MAX];
+		_fds[0].fd = INTERNAL_get_event_fd(window);
+		_fds[1].fd = window->internal._wake_fd;
+		int _count = 2 + INTERNAL_gamepad_fds(_fds + 2, GAMEPAD_FD_MAX);
+
+		if (_count > max)
+		{
+			_count = max > 0 ? max : 0;
+		}
+
+		for (int i = 0; i < _count; i++)
+		{
+			fds[i] = _fds[i].fd;
+		}
+
+		return _count;
+	}
+
+	void INTERNAL_dispatch_pending(window *window)
+	{
+		PCFW_TRACE_SCOPE("dispatch_pending");
+
+#ifdef PCFW_WAYLAND
+		if (window->internal._backend == BACKEND_WAYLAND)
+		{
+			WAYLAND_dispatch_pending(window);
+			return;
+		}
+#endif
+
+		// Only what Xlib has read already, the socket isn't touched
+		while (XEventsQueued(window->internal._display, QueuedAlready) > 0)
+		{
+			XNextEvent(window->internal._display, &window->internal._event);
+			handle_event(window);
+		}
+	}
+
+	int INTERNAL_prepare_events(window *window)
+	{
+#ifdef PCFW_WAYLAND
+		if (window->internal._backend == BACKEND_WAYLAND)
+		{
+			return WAYLAND_prepare_events(window);
+		}
+#endif
+
+		// Replies read by other calls may have brought events with them, the fd won't wake up for those
+		XFlush(window->internal._display);
+		return XEventsQueued(window->internal._display, QueuedAlready) > 0;
+	}
+
+	void INTERNAL_check_events(window *window)
+	{
+		PCFW_TRACE_SCOPE("check_events");
+
+		// The loop may have woken up for `request_redraw`, and the eventfd would keep waking it up. The polls of both
+		// backends can skip it
+		INTERNAL_clear_wake_fd(window->internal._wake_fd);
+
+#ifdef PCFW_WAYLAND
+		if (window->internal._backend == BACKEND_WAYLAND)
+		{
+			WAYLAND_check_events(window);
+			return;
+		}
+#endif
+
+		// Never blocks, it reads what the socket has
+		process_events(window, 0);
+	}
+
+    int INTERNAL_make_context_current(window *window)
+    {
+#ifdef PCFW_WAYLAND
+        if (window->internal._backend == BACKEND_WAYLAND)
+        {
+            return WAYLAND_make_context_current(window);
+        }
+#endif
+
+        if (!window->internal._gl_context)
+        {
+            Log::error("PCFW Internal: The window was created without OpenGL context");
+            return 1;
+        }
+
+        if (!glXMakeCurrent(window->internal._display, window->internal._handle, window->internal._gl_context))
         {
             Log::error("PCFW Internal: Failed to make context current");
             return 1;
@@ -358,6 +2295,18 @@ namespace PC::Framework
     
     void INTERNAL_set_swap_interval(window *window, int interval)
     {
+#ifdef PCFW_WAYLAND
+        if (window->internal._backend == BACKEND_WAYLAND)
+        {
+            WAYLAND_set_swap_interval(window, interval);
+            return;
+        }
+#endif
+
+        if (!window->internal._gl_context)
+        {
+            return;
+        }
 
         static PFNGLXSWAPINTERVALEXTPROC _swap_interval = nullptr;
 
@@ -365,38 +2314,215 @@ namespace PC::Framework
         {
             _swap_interval = (PFNGLXSWAPINTERVALEXTPROC)glXGetProcAddress((const GLubyte *)"glXSwapIntervalEXT");
         }
-        else
+
+        if (_swap_interval)
         {
             _swap_interval(window->internal._display, window->internal._handle, interval);
         }
     }
 
+    // Frame limiter
 
-    // void get_cursor_position(window *window, int *x, int *y)
-    // {
-    //     Window _root;
-    //     Window _child;
+    // First guess of how late `clock_nanosleep` wakes up, and the limits of what is learned
+    constexpr long long FRAME_LIMITER_BUDGET = 1000000;
+    constexpr long long FRAME_LIMITER_BUDGET_MIN = 50000;
+    constexpr long long FRAME_LIMITER_BUDGET_MAX = 4000000;
+    // Added to the measured lateness, so a slightly later wake up doesn't miss the deadline
+    constexpr long long FRAME_LIMITER_MARGIN = 50000;
 
-    //     int _root_x, _root_y;
+    void INTERNAL_set_target_frame_rate(window *window, double frame_rate)
+    {
+        INTERNAL_frame_limiter &_limiter = window->internal._limiter;
 
-    //     unsigned int _mask;
+        _limiter._period = frame_rate > 0.0 ? static_cast<long long>(1e9 / frame_rate) : 0;
+        _limiter._deadline = 0;
 
-    //     XQueryPointer(window->_display, window->_window, &_root, &_child, &_root_x, &_root_y, x, y, &_mask);
-    // }
+        if (!_limiter._budget)
+        {
+            _limiter._budget = FRAME_LIMITER_BUDGET;
+        }
+    }
 
-    // int get_key(window *window, int key, int type)
-    // {
-    //     if (type == KEY_PRESS)
-    //     {
-    //         return window->key_state[key];
-    //     }
-    //     else if (type == KEY_RELEASE)
-    //     {
-    //         return !window->key_state[key];
-    //     }
+    int INTERNAL_get_window_visibility(window *window)
+    {
+        if (window->internal._backend != BACKEND_X11)
+        {
+            return VISIBILITY_VISIBLE;
+        }
 
-    //     return 0;
-    // }
+        if (!window->internal._mapped || window->internal._minimized)
+        {
+            return VISIBILITY_HIDDEN;
+        }
+
+        return window->internal._obscured ? VISIBILITY_OBSCURED : VISIBILITY_VISIBLE;
+    }
+
+    void INTERNAL_set_hidden_frame_rate(window *window, double frame_rate)
+    {
+        INTERNAL_frame_limiter &_limiter = window->internal._limiter;
+
+        _limiter._hidden_period = frame_rate > 0.0 ? static_cast<long long>(1e9 / frame_rate) : 0;
+        _limiter._hidden_deadline = 0;
+    }
+
+    // Nobody sees these frames, so there's no spinning to keep them even
+    static void wait_hidden_frame(INTERNAL_frame_limiter &limiter)
+    {
+        long long _now = monotonic_time();
+
+        // Like the visible frames, the schedule starts again after a gap, e.g. the window was visible meanwhile
+        if (!limiter._hidden_deadline || _now - limiter._hidden_deadline > limiter._hidden_period)
+        {
+            limiter._hidden_deadline = _now + limiter._hidden_period;
+            return;
+        }
+
+        timespec _time = {static_cast<time_t>(limiter._hidden_deadline / 1000000000LL), static_cast<long>(limiter._hidden_deadline % 1000000000LL)};
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &_time, nullptr) == EINTR)
+        {
+        }
+
+        limiter._hidden_deadline += limiter._hidden_period;
+    }
+
+    void INTERNAL_wait_frame(window *window)
+    {
+        PCFW_TRACE_SCOPE("wait_frame");
+
+        INTERNAL_frame_limiter &_limiter = window->internal._limiter;
+
+        if (_limiter._hidden_period && INTERNAL_get_window_visibility(window) != VISIBILITY_VISIBLE)
+        {
+            // The scheduler swaps the other windows right after the first, a sleep of theirs would slow the visible ones too
+            scheduler *_scheduler = window->config._scheduler;
+            if (_scheduler && (_scheduler->_windows.front() != window || paces_visible_windows(window)))
+            {
+                return;
+            }
+
+            wait_hidden_frame(_limiter);
+            return;
+        }
+
+        if (!_limiter._period)
+        {
+            return;
+        }
+
+        long long _now = monotonic_time();
+
+        // The first frame and the frames late by a whole period start the schedule again, instead of hurrying to catch up
+        if (!_limiter._deadline || _now - _limiter._deadline > _limiter._period)
+        {
+            _limiter._deadline = _now + _limiter._period;
+            return;
+        }
+
+        // Sleeping until a bit before the deadline, the budget is what the scheduler usually wakes up late
+        long long _wake = _limiter._deadline - _limiter._budget;
+        if (_wake > _now)
+        {
+            timespec _time = {static_cast<time_t>(_wake / 1000000000LL), static_cast<long>(_wake % 1000000000LL)};
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &_time, nullptr) == EINTR)
+            {
+            }
+
+            // Late wake ups raise the budget at once, early ones lower it slowly
+            long long _needed = monotonic_time() - _wake + FRAME_LIMITER_MARGIN;
+            if (_needed > _limiter._budget)
+            {
+                _limiter._budget = _needed;
+            }
+            else
+            {
+                _limiter._budget -= (_limiter._budget - _needed) / 16;
+            }
+
+            _limiter._budget = std::clamp(_limiter._budget, FRAME_LIMITER_BUDGET_MIN, FRAME_LIMITER_BUDGET_MAX);
+        }
+
+        // Spinning the rest, `clock_gettime` doesn't enter the kernel
+        while (monotonic_time() < _limiter._deadline)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+
+        _limiter._deadline += _limiter._period;
+    }
+
+    int INTERNAL_get_key(window *window, int key, int type)
+    {
+        // Kept by the key events of both backends, so it needs `EVENTS_KEY` or a key callback
+        bool _pressed = window->config._key_state[key];
+
+        if (type == KEY_PRESS)
+        {
+            return _pressed;
+        }
+
+        if (type == KEY_RELEASE)
+        {
+            return !_pressed;
+        }
+
+        return 0;
+    }
+
+    int INTERNAL_get_cursor_position(window *window, int *x, int *y)
+    {
+#ifdef PCFW_WAYLAND
+        if (window->internal._backend == BACKEND_WAYLAND)
+        {
+            return WAYLAND_get_cursor_position(window, x, y);
+        }
+#endif
+
+        // Using the query sent by `INTERNAL_poll_events` if it's from this frame, its reply is probably already here.
+        // One from an earlier frame tells where the cursor was back then
+        xcb_query_pointer_cookie_t _cookie;
+        bool _prefetched = window->internal._pointer_request && window->internal._pointer_frame == window->config._frame_arenas._frame.load(std::memory_order_relaxed);
+
+        if (_prefetched)
+        {
+            _cookie.sequence = window->internal._pointer_request;
+        }
+        else
+        {
+            if (window->internal._pointer_request)
+            {
+                xcb_discard_reply(window->internal._connection, window->internal._pointer_request);
+            }
+
+            _cookie = xcb_query_pointer(window->internal._connection, window->internal._handle);
+        }
+
+        window->internal._pointer_request = 0;
+
+        window->internal._pointer_wanted = true;
+
+        xcb_query_pointer_reply_t *_reply = xcb_query_pointer_reply(window->internal._connection, _cookie, nullptr);
+        if (!_reply)
+        {
+            Log::error("PCFW Internal: Failed to query the cursor position");
+            return 1;
+        }
+
+        if (x)
+        {
+            *x = _reply->win_x;
+        }
+
+        if (y)
+        {
+            *y = _reply->win_y;
+        }
+
+        free(_reply);
+        return 0;
+    }
 
     
     // const char *get_window_title(window *window)
@@ -416,6 +2542,90 @@ namespace PC::Framework
 
     
 
+    const char **INTERNAL_get_required_instance_extensions(unsigned int *count)
+    {
+        static const char *_extensions[]
+        {
+            "VK_KHR_surface",
+            "VK_KHR_xlib_surface"
+        };
+
+        *count = 2;
+        return _extensions;
+    }
+
+#ifdef PCFW_VULKAN
+    // The Vulkan loader is opened at the first surface, so applications using only OpenGL don't load it
+    static PFN_vkGetInstanceProcAddr load_vulkan()
+    {
+        // Looked for once, a missing loader isn't opened again. A found one stays open for the surfaces of the process
+        static const PFN_vkGetInstanceProcAddr _get_instance_proc_address = []() -> PFN_vkGetInstanceProcAddr {
+            static const char *const _names[] = {"libvulkan.so.1", "libvulkan.so", nullptr};
+            void *_library = INTERNAL_open_library(_names);
+            if (!_library)
+            {
+                return nullptr;
+            }
+
+            PFN_vkGetInstanceProcAddr _function = reinterpret_cast<PFN_vkGetInstanceProcAddr>(dlsym(_library, "vkGetInstanceProcAddr"));
+            if (!_function)
+            {
+                dlclose(_library);
+            }
+
+            return _function;
+        }();
+
+        if (!_get_instance_proc_address)
+        {
+            Log::error("PCFW Internal: Failed to load the Vulkan loader");
+        }
+
+        return _get_instance_proc_address;
+    }
+
+    int create_vulkan_surface(VkInstance instance, window *window, VkSurfaceKHR *surface)
+    {
+        if (!PCFW_VALIDATE(instance, "No instance to create the Vulkan surface") || !PCFW_VALIDATE(window, "No window to create the Vulkan surface") || !PCFW_VALIDATE(surface, "No variable to storage the Vulkan surface"))
+        {
+            return 1;
+        }
+
+        if (window->internal._backend != BACKEND_X11 || window->internal._gl_context)
+        {
+            Log::error("PCFW Internal: Vulkan surfaces need a window created with CLIENT_API_NONE");
+            return 1;
+        }
+
+        PFN_vkGetInstanceProcAddr _get_instance_proc_address = load_vulkan();
+        if (!_get_instance_proc_address)
+        {
+            return 1;
+        }
+
+        PFN_vkCreateXlibSurfaceKHR _create_xlib_surface = reinterpret_cast<PFN_vkCreateXlibSurfaceKHR>(_get_instance_proc_address(instance, "vkCreateXlibSurfaceKHR"));
+        if (!_create_xlib_surface)
+        {
+            Log::error("PCFW Internal: The instance was created without VK_KHR_xlib_surface");
+            return 1;
+        }
+
+        VkXlibSurfaceCreateInfoKHR _info = {};
+        _info.sType = VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR;
+        _info.dpy = window->internal._display;
+        _info.window = window->internal._handle;
+
+        VkResult _result = _create_xlib_surface(instance, &_info, nullptr, surface);
+        if (_result != VK_SUCCESS)
+        {
+            Log::error("PCFW Internal: Failed to create Vulkan surface (VkResult %d)", static_cast<int>(_result));
+            return 1;
+        }
+
+        return 0;
+    }
+#endif
+
     int INTERNAL_get_window_width(window *window)
     {
         return window ? window->config._width : 0;
@@ -427,6 +2637,14 @@ namespace PC::Framework
     
     void INTERNAL_set_window_limits(window *window, int minimum_width, int minimum_height, int maximum_width, int maximum_height)
     {
+#ifdef PCFW_WAYLAND
+        if (window->internal._backend == BACKEND_WAYLAND)
+        {
+            WAYLAND_set_window_limits(window, minimum_width, minimum_height, maximum_width, maximum_height);
+            return;
+        }
+#endif
+
         XSizeHints *size_hints = XAllocSizeHints();   
         size_hints->flags = PMinSize;
         
@@ -446,11 +2664,30 @@ namespace PC::Framework
         XFree(size_hints);
     }
 
+    int INTERNAL_get_current_backend()
+    {
+        return _current_backend;
+    }
+
     void *INTERNAL_get_proc_address(const char *proc)
     {
         if (!proc)
             return nullptr;
 
+#ifdef PCFW_WAYLAND
+        if (_current_backend == BACKEND_WAYLAND)
+        {
+            return WAYLAND_get_proc_address(proc);
+        }
+#endif
+
+        // No OpenGL window was created yet
+        if (!_x11._glx)
+        {
+            Log::error("PCFW Internal: libGL isn't loaded, create an OpenGL window first");
+            return nullptr;
+        }
+
         void *_address = (void*)glXGetProcAddress((const GLubyte*)proc);
         
         if (!_address)
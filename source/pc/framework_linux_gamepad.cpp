@@ -0,0 +1,451 @@
+// Author: oknauta
+// License: MIT
+// File: framework_linux_gamepad.cpp
+// Date: 2026-10-19
+
+#ifdef __linux__
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <linux/input.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    // Events read at once from a fd
+    constexpr int GAMEPAD_READ_BATCH = 64;
+
+    struct gamepad
+    {
+        int _fd;
+        // Empty for the fds given to `INTERNAL_gamepad_attach_fd`
+        char _path[64];
+        // What the users see, and what is being received until the next `SYN_REPORT`
+        gamepad_state _state;
+        gamepad_state _pending;
+        input_absinfo _range[GAMEPAD_AXIS_COUNT];
+        // The kernel dropped events. The rest of the report is stale, it's skipped until the next `SYN_REPORT`
+        bool _dropped;
+    };
+
+    static gamepad _gamepads[GAMEPAD_MAX];
+    static int _inotify = -1;
+    static bool _enabled = false;
+
+    // evdev axes, in the order of `GAMEPAD_AXIS_*`
+    static const unsigned int _axis_codes[GAMEPAD_AXIS_COUNT] = {ABS_X, ABS_Y, ABS_Z, ABS_RX, ABS_RY, ABS_RZ, ABS_HAT0X, ABS_HAT0Y};
+
+    static bool test_bit(const unsigned long *bits, unsigned int bit)
+    {
+        return (bits[bit / (8 * sizeof(unsigned long))] >> (bit % (8 * sizeof(unsigned long)))) & 1;
+    }
+
+    static int button_index(unsigned int code)
+    {
+        if (code >= BTN_GAMEPAD && code < BTN_GAMEPAD + GAMEPAD_BUTTON_COUNT)
+        {
+            return code - BTN_GAMEPAD;
+        }
+
+        // Joysticks use the buttons before the gamepad ones
+        if (code >= BTN_JOYSTICK && code < BTN_JOYSTICK + GAMEPAD_BUTTON_COUNT)
+        {
+            return code - BTN_JOYSTICK;
+        }
+
+        return -1;
+    }
+
+    static int axis_index(unsigned int code)
+    {
+        for (int i = 0; i < GAMEPAD_AXIS_COUNT; i++)
+        {
+            if (_axis_codes[i] == code)
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    static float normalize_axis(const gamepad &gamepad, int axis, int value)
+    {
+        const input_absinfo &_range = gamepad._range[axis];
+
+        if (_range.maximum <= _range.minimum)
+        {
+            return 0.0f;
+        }
+
+        float _normalized = static_cast<float>(value - _range.minimum) / static_cast<float>(_range.maximum - _range.minimum);
+
+        // Triggers rest at their minimum, the other axes at their center
+        if (axis == GAMEPAD_AXIS_LEFT_TRIGGER || axis == GAMEPAD_AXIS_RIGHT_TRIGGER)
+        {
+            return _normalized;
+        }
+
+        return _normalized * 2.0f - 1.0f;
+    }
+
+    // Ranges used when the fd doesn't answer `EVIOCGABS`, like the fake ones of the tests
+    static void set_default_ranges(gamepad &gamepad)
+    {
+        for (int i = 0; i < GAMEPAD_AXIS_COUNT; i++)
+        {
+            gamepad._range[i] = {};
+
+            if (i == GAMEPAD_AXIS_LEFT_TRIGGER || i == GAMEPAD_AXIS_RIGHT_TRIGGER)
+            {
+                gamepad._range[i].maximum = 255;
+            }
+            else if (i == GAMEPAD_AXIS_HAT_X || i == GAMEPAD_AXIS_HAT_Y)
+            {
+                gamepad._range[i].minimum = -1;
+                gamepad._range[i].maximum = 1;
+            }
+            else
+            {
+                gamepad._range[i].minimum = -32768;
+                gamepad._range[i].maximum = 32767;
+            }
+        }
+    }
+
+    // Reads the whole state from the device, when it's opened or when the kernel dropped events
+    static void synchronize(gamepad &gamepad)
+    {
+        unsigned long _keys[KEY_CNT / (8 * sizeof(unsigned long)) + 1] = {};
+        if (ioctl(gamepad._fd, EVIOCGKEY(sizeof(_keys)), _keys) >= 0)
+        {
+            // Every button is assigned, the ones released while events were dropped too
+            for (int i = 0; i < GAMEPAD_BUTTON_COUNT; i++)
+            {
+                gamepad._pending.buttons[i] = test_bit(_keys, BTN_GAMEPAD + i) || test_bit(_keys, BTN_JOYSTICK + i);
+            }
+        }
+
+        for (int i = 0; i < GAMEPAD_AXIS_COUNT; i++)
+        {
+            input_absinfo _info;
+            if (ioctl(gamepad._fd, EVIOCGABS(_axis_codes[i]), &_info) >= 0)
+            {
+                gamepad._range[i] = _info;
+                gamepad._pending.axes[i] = normalize_axis(gamepad, i, _info.value);
+            }
+        }
+
+        gamepad._state = gamepad._pending;
+    }
+
+    static int add_gamepad(int fd, const char *path, const char *name)
+    {
+        for (int i = 0; i < GAMEPAD_MAX; i++)
+        {
+            gamepad &_gamepad = _gamepads[i];
+            if (_gamepad._state.connected)
+            {
+                continue;
+            }
+
+            _gamepad = {};
+            _gamepad._fd = fd;
+            snprintf(_gamepad._path, sizeof(_gamepad._path), "%s", path ? path : "");
+
+            _gamepad._pending.connected = true;
+            snprintf(_gamepad._pending.name, sizeof(_gamepad._pending.name), "%s", name ? name : "Gamepad");
+
+            set_default_ranges(_gamepad);
+            synchronize(_gamepad);
+
+            return i;
+        }
+
+        PC::Log::warning("PCFW Internal: No free slot for another gamepad");
+        return -1;
+    }
+
+    static void remove_gamepad(gamepad &gamepad)
+    {
+        close(gamepad._fd);
+        gamepad = {};
+        gamepad._fd = -1;
+    }
+
+    static void open_device(const char *path)
+    {
+        for (const gamepad &_gamepad : _gamepads)
+        {
+            if (_gamepad._state.connected && strcmp(_gamepad._path, path) == 0)
+            {
+                return;
+            }
+        }
+
+        // Devices without permission are tried again on `IN_ATTRIB`, when udev changes it
+        int _fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (_fd < 0)
+        {
+            return;
+        }
+
+        // Only devices with gamepad or joystick buttons are kept
+        unsigned long _keys[KEY_CNT / (8 * sizeof(unsigned long)) + 1] = {};
+        if (ioctl(_fd, EVIOCGBIT(EV_KEY, sizeof(_keys)), _keys) < 0 || (!test_bit(_keys, BTN_GAMEPAD) && !test_bit(_keys, BTN_JOYSTICK)))
+        {
+            close(_fd);
+            return;
+        }
+
+        char _name[128] = "Gamepad";
+        ioctl(_fd, EVIOCGNAME(sizeof(_name)), _name);
+
+        if (add_gamepad(_fd, path, _name) < 0)
+        {
+            close(_fd);
+        }
+    }
+
+    static void enable_gamepads()
+    {
+        _enabled = true;
+
+        _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_inotify >= 0 && inotify_add_watch(_inotify, "/dev/input", IN_CREATE | IN_ATTRIB | IN_DELETE) < 0)
+        {
+            close(_inotify);
+            _inotify = -1;
+        }
+
+        if (_inotify < 0)
+        {
+            PC::Log::warning("PCFW Internal: Failed to watch /dev/input, gamepads won't be hotplugged");
+        }
+
+        DIR *_directory = opendir("/dev/input");
+        if (!_directory)
+        {
+            return;
+        }
+
+        while (dirent *_entry = readdir(_directory))
+        {
+            if (strncmp(_entry->d_name, "event", 5) == 0)
+            {
+                char _path[64];
+                snprintf(_path, sizeof(_path), "/dev/input/%.32s", _entry->d_name);
+                open_device(_path);
+            }
+        }
+
+        closedir(_directory);
+    }
+
+    static void handle_hotplug()
+    {
+        alignas(inotify_event) char _buffer[4096];
+
+        ssize_t _size;
+        while ((_size = read(_inotify, _buffer, sizeof(_buffer))) > 0)
+        {
+            for (char *_position = _buffer; _position < _buffer + _size;)
+            {
+                const inotify_event *_event = reinterpret_cast<const inotify_event *>(_position);
+                _position += sizeof(inotify_event) + _event->len;
+
+                if (_event->len == 0 || strncmp(_event->name, "event", 5) != 0)
+                {
+                    continue;
+                }
+
+                char _path[64];
+                snprintf(_path, sizeof(_path), "/dev/input/%.32s", _event->name);
+
+                if (_event->mask & (IN_CREATE | IN_ATTRIB))
+                {
+                    open_device(_path);
+                }
+                else if (_event->mask & IN_DELETE)
+                {
+                    for (gamepad &_gamepad : _gamepads)
+                    {
+                        if (_gamepad._state.connected && strcmp(_gamepad._path, _path) == 0)
+                        {
+                            remove_gamepad(_gamepad);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    static void read_gamepad(gamepad &gamepad)
+    {
+        input_event _events[GAMEPAD_READ_BATCH];
+
+        while (true)
+        {
+            ssize_t _size = read(gamepad._fd, _events, sizeof(_events));
+            if (_size < 0)
+            {
+                if (errno != EAGAIN && errno != EINTR)
+                {
+                    remove_gamepad(gamepad);
+                }
+                return;
+            }
+
+            // The write end of a fake fd was closed
+            if (_size == 0)
+            {
+                remove_gamepad(gamepad);
+                return;
+            }
+
+            for (size_t i = 0; i < static_cast<size_t>(_size) / sizeof(input_event); i++)
+            {
+                const input_event &_event = _events[i];
+
+                if (gamepad._dropped)
+                {
+                    // The state is read from the device once the report that had the drop ends
+                    if (_event.type == EV_SYN && _event.code == SYN_REPORT)
+                    {
+                        gamepad._dropped = false;
+                        synchronize(gamepad);
+                    }
+                    continue;
+                }
+
+                switch (_event.type)
+                {
+                case EV_KEY:
+                {
+                    int _button = button_index(_event.code);
+                    if (_button >= 0)
+                    {
+                        gamepad._pending.buttons[_button] = _event.value != 0;
+                    }
+                    break;
+                }
+                case EV_ABS:
+                {
+                    int _axis = axis_index(_event.code);
+                    if (_axis >= 0)
+                    {
+                        gamepad._pending.axes[_axis] = normalize_axis(gamepad, _axis, _event.value);
+                    }
+                    break;
+                }
+                case EV_SYN:
+                    // A report is complete, it becomes the snapshot
+                    if (_event.code == SYN_REPORT)
+                    {
+                        gamepad._state = gamepad._pending;
+                    }
+                    else if (_event.code == SYN_DROPPED)
+                    {
+                        gamepad._dropped = true;
+                    }
+                    break;
+                }
+            }
+
+            if (_size < static_cast<ssize_t>(sizeof(_events)))
+            {
+                return;
+            }
+        }
+    }
+
+    int INTERNAL_gamepad_fds(pollfd *fds, int max)
+    {
+        if (!_enabled)
+        {
+            return 0;
+        }
+
+        int _count = 0;
+
+        if (_inotify >= 0 && _count < max)
+        {
+            fds[_count++] = {_inotify, POLLIN, 0};
+        }
+
+        for (const gamepad &_gamepad : _gamepads)
+        {
+            if (_gamepad._state.connected && _count < max)
+            {
+                fds[_count++] = {_gamepad._fd, POLLIN, 0};
+            }
+        }
+
+        return _count;
+    }
+
+    void INTERNAL_gamepad_process(const pollfd *fds, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                continue;
+            }
+
+            if (fds[i].fd == _inotify)
+            {
+                handle_hotplug();
+                continue;
+            }
+
+            for (gamepad &_gamepad : _gamepads)
+            {
+                if (_gamepad._state.connected && _gamepad._fd == fds[i].fd)
+                {
+                    read_gamepad(_gamepad);
+                    break;
+                }
+            }
+        }
+    }
+
+    int INTERNAL_gamepad_attach_fd(int fd, const char *name)
+    {
+        if (!_enabled)
+        {
+            enable_gamepads();
+        }
+
+        int _flags = fcntl(fd, F_GETFL);
+        if (_flags < 0 || fcntl(fd, F_SETFL, _flags | O_NONBLOCK) < 0)
+        {
+            PC::Log::error("PCFW Internal: Failed to make the gamepad fd non-blocking");
+            return -1;
+        }
+
+        return add_gamepad(fd, nullptr, name);
+    }
+
+    int INTERNAL_get_gamepad_state(int gamepad, gamepad_state *state)
+    {
+        if (!_enabled)
+        {
+            enable_gamepads();
+        }
+
+        *state = _gamepads[gamepad]._state;
+        return state->connected ? 0 : 1;
+    }
+} // namespace PCFW
+
+#endif
@@ -0,0 +1,515 @@
+// Author: oknauta
+// License: MIT
+// File: framework_pixels.cpp
+// Date: 2026-10-19
+
+#include "pc/framework_pixels.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PCFW_PIXELS_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define PCFW_PIXELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace PC::Framework
+{
+    // Every kernel gives the same bytes as the scalar one, the vectors only do more pixels at once.
+    // The scalar code also finishes what's left after the last whole vector
+
+    struct pixel_kernels
+    {
+        int _kind;
+        void (*_swap_rows)(unsigned char *a, unsigned char *b, size_t size);
+        void (*_swizzle_red_blue)(unsigned char *destination, const unsigned char *source, size_t count);
+        void (*_premultiply_alpha)(unsigned char *destination, const unsigned char *source, size_t count);
+        void (*_unorm8_to_float)(float *destination, const unsigned char *source, size_t count);
+        void (*_float_to_unorm8)(unsigned char *destination, const float *source, size_t count);
+    };
+
+    // The multiplication, not a division, so the vectors round the same way
+    constexpr float UNORM8_SCALE = 1.0f / 255.0f;
+
+    // c * a / 255, rounded to the nearest. Exact for every pair of bytes and fits in 16 bits
+    static inline unsigned char multiply_unorm8(unsigned int c, unsigned int a)
+    {
+        unsigned int _product = c * a + 128;
+        return static_cast<unsigned char>((_product + (_product >> 8)) >> 8);
+    }
+
+    static void scalar_swap_rows(unsigned char *a, unsigned char *b, size_t size)
+    {
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t _a;
+            uint64_t _b;
+            memcpy(&_a, a + i, sizeof(_a));
+            memcpy(&_b, b + i, sizeof(_b));
+            memcpy(a + i, &_b, sizeof(_b));
+            memcpy(b + i, &_a, sizeof(_a));
+        }
+
+        for (; i < size; i++)
+        {
+            unsigned char _a = a[i];
+            a[i] = b[i];
+            b[i] = _a;
+        }
+    }
+
+    static void scalar_swizzle_red_blue(unsigned char *destination, const unsigned char *source, size_t count)
+    {
+        for (size_t i = 0; i < count * 4; i += 4)
+        {
+            unsigned char _red = source[i];
+            unsigned char _blue = source[i + 2];
+            destination[i] = _blue;
+            destination[i + 1] = source[i + 1];
+            destination[i + 2] = _red;
+            destination[i + 3] = source[i + 3];
+        }
+    }
+
+    static void scalar_premultiply_alpha(unsigned char *destination, const unsigned char *source, size_t count)
+    {
+        for (size_t i = 0; i < count * 4; i += 4)
+        {
+            unsigned char _alpha = source[i + 3];
+            destination[i] = multiply_unorm8(source[i], _alpha);
+            destination[i + 1] = multiply_unorm8(source[i + 1], _alpha);
+            destination[i + 2] = multiply_unorm8(source[i + 2], _alpha);
+            destination[i + 3] = _alpha;
+        }
+    }
+
+    static void scalar_unorm8_to_float(float *destination, const unsigned char *source, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            destination[i] = static_cast<float>(source[i]) * UNORM8_SCALE;
+        }
+    }
+
+    static void scalar_float_to_unorm8(unsigned char *destination, const float *source, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            // Written so NaN becomes 0, like the max of SSE
+            float _value = source[i] > 0.0f ? source[i] : 0.0f;
+            _value = _value < 1.0f ? _value : 1.0f;
+            _value = _value * 255.0f;
+            destination[i] = static_cast<unsigned char>(static_cast<int>(_value + 0.5f));
+        }
+    }
+
+    static const pixel_kernels SCALAR_KERNELS = {PIXEL_KERNELS_SCALAR, scalar_swap_rows, scalar_swizzle_red_blue, scalar_premultiply_alpha, scalar_unorm8_to_float, scalar_float_to_unorm8};
+
+#ifdef PCFW_PIXELS_X86
+    // The kernels have the instruction sets as target attributes, so the library is still built for the base x86
+
+    __attribute__((target("sse2"))) static void sse2_swap_rows(unsigned char *a, unsigned char *b, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i _a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            __m128i _b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(a + i), _b);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(b + i), _a);
+        }
+
+        scalar_swap_rows(a + i, b + i, size - i);
+    }
+
+    // SSE2 has no byte shuffle, the channels are moved with shifts inside each pixel
+    __attribute__((target("sse2"))) static void sse2_swizzle_red_blue(unsigned char *destination, const unsigned char *source, size_t count)
+    {
+        const __m128i _green_alpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+        const __m128i _low = _mm_set1_epi32(0x000000FF);
+        const __m128i _high = _mm_set1_epi32(0x00FF0000);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i _pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 4));
+            __m128i _result = _mm_and_si128(_pixels, _green_alpha);
+            _result = _mm_or_si128(_result, _mm_and_si128(_mm_srli_epi32(_pixels, 16), _low));
+            _result = _mm_or_si128(_result, _mm_and_si128(_mm_slli_epi32(_pixels, 16), _high));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i * 4), _result);
+        }
+
+        scalar_swizzle_red_blue(destination + i * 4, source + i * 4, count - i);
+    }
+
+    // Two pixels of 16-bit channels, with the alpha of each pixel in its four lanes
+    __attribute__((target("sse2"))) static inline __m128i sse2_premultiply(__m128i channels)
+    {
+        __m128i _alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, 0xFF), 0xFF);
+        __m128i _product = _mm_add_epi16(_mm_mullo_epi16(channels, _alpha), _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(_product, _mm_srli_epi16(_product, 8)), 8);
+    }
+
+    __attribute__((target("sse2"))) static void sse2_premultiply_alpha(unsigned char *destination, const unsigned char *source, size_t count)
+    {
+        const __m128i _zero = _mm_setzero_si128();
+        const __m128i _alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i _pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i * 4));
+            __m128i _low = sse2_premultiply(_mm_unpacklo_epi8(_pixels, _zero));
+            __m128i _high = sse2_premultiply(_mm_unpackhi_epi8(_pixels, _zero));
+
+            // The alpha was multiplied by itself, the original one is put back
+            __m128i _result = _mm_andnot_si128(_alpha_mask, _mm_packus_epi16(_low, _high));
+            _result = _mm_or_si128(_result, _mm_and_si128(_pixels, _alpha_mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i * 4), _result);
+        }
+
+        scalar_premultiply_alpha(destination + i * 4, source + i * 4, count - i);
+    }
+
+    __attribute__((target("sse2"))) static void sse2_unorm8_to_float(float *destination, const unsigned char *source, size_t count)
+    {
+        const __m128i _zero = _mm_setzero_si128();
+        const __m128 _scale = _mm_set1_ps(UNORM8_SCALE);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i _bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+            __m128i _low = _mm_unpacklo_epi8(_bytes, _zero);
+            __m128i _high = _mm_unpackhi_epi8(_bytes, _zero);
+
+            _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_low, _zero)), _scale));
+            _mm_storeu_ps(destination + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(_low, _zero)), _scale));
+            _mm_storeu_ps(destination + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_high, _zero)), _scale));
+            _mm_storeu_ps(destination + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(_high, _zero)), _scale));
+        }
+
+        scalar_unorm8_to_float(destination + i, source + i, count - i);
+    }
+
+    __attribute__((target("sse2"))) static inline __m128i sse2_to_unorm8(const float *source)
+    {
+        __m128 _value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        _value = _mm_add_ps(_mm_mul_ps(_value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+        return _mm_cvttps_epi32(_value);
+    }
+
+    __attribute__((target("sse2"))) static void sse2_float_to_unorm8(unsigned char *destination, const float *source, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i _low = _mm_packs_epi32(sse2_to_unorm8(source + i), sse2_to_unorm8(source + i + 4));
+            __m128i _high = _mm_packs_epi32(sse2_to_unorm8(source + i + 8), sse2_to_unorm8(source + i + 12));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_packus_epi16(_low, _high));
+        }
+
+        scalar_float_to_unorm8(destination + i, source + i, count - i);
+    }
+
+    static const pixel_kernels SSE2_KERNELS = {PIXEL_KERNELS_SSE2, sse2_swap_rows, sse2_swizzle_red_blue, sse2_premultiply_alpha, sse2_unorm8_to_float, sse2_float_to_unorm8};
+
+    __attribute__((target("avx2"))) static void avx2_swap_rows(unsigned char *a, unsigned char *b, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i _a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i _b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(a + i), _b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(b + i), _a);
+        }
+
+        sse2_swap_rows(a + i, b + i, size - i);
+    }
+
+    __attribute__((target("avx2"))) static void avx2_swizzle_red_blue(unsigned char *destination, const unsigned char *source, size_t count)
+    {
+        const __m256i _order = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i _pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i * 4));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i * 4), _mm256_shuffle_epi8(_pixels, _order));
+        }
+
+        sse2_swizzle_red_blue(destination + i * 4, source + i * 4, count - i);
+    }
+
+    __attribute__((target("avx2"))) static inline __m256i avx2_premultiply(__m256i channels)
+    {
+        __m256i _alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(channels, 0xFF), 0xFF);
+        __m256i _product = _mm256_add_epi16(_mm256_mullo_epi16(channels, _alpha), _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(_product, _mm256_srli_epi16(_product, 8)), 8);
+    }
+
+    __attribute__((target("avx2"))) static void avx2_premultiply_alpha(unsigned char *destination, const unsigned char *source, size_t count)
+    {
+        const __m256i _zero = _mm256_setzero_si256();
+        const __m256i _alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            // Unpacking and packing stay inside each 128-bit half, so the pixels come back in order
+            __m256i _pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i * 4));
+            __m256i _low = avx2_premultiply(_mm256_unpacklo_epi8(_pixels, _zero));
+            __m256i _high = avx2_premultiply(_mm256_unpackhi_epi8(_pixels, _zero));
+
+            __m256i _result = _mm256_blendv_epi8(_mm256_packus_epi16(_low, _high), _pixels, _alpha_mask);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i * 4), _result);
+        }
+
+        sse2_premultiply_alpha(destination + i * 4, source + i * 4, count - i);
+    }
+
+    __attribute__((target("avx2"))) static void avx2_unorm8_to_float(float *destination, const unsigned char *source, size_t count)
+    {
+        const __m256 _scale = _mm256_set1_ps(UNORM8_SCALE);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i _bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+            _mm256_storeu_ps(destination + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_bytes)), _scale));
+            _mm256_storeu_ps(destination + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(_bytes, 8))), _scale));
+        }
+
+        sse2_unorm8_to_float(destination + i, source + i, count - i);
+    }
+
+    __attribute__((target("avx2"))) static inline __m256i avx2_to_unorm8(const float *source)
+    {
+        __m256 _value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source), _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+        _value = _mm256_add_ps(_mm256_mul_ps(_value, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f));
+        return _mm256_cvttps_epi32(_value);
+    }
+
+    __attribute__((target("avx2"))) static void avx2_float_to_unorm8(unsigned char *destination, const float *source, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            // Packing works inside each 128-bit half, so the groups of four bytes come out interleaved
+            __m256i _low = _mm256_packs_epi32(avx2_to_unorm8(source + i), avx2_to_unorm8(source + i + 8));
+            __m256i _high = _mm256_packs_epi32(avx2_to_unorm8(source + i + 16), avx2_to_unorm8(source + i + 24));
+            __m256i _bytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(_low, _high), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _bytes);
+        }
+
+        sse2_float_to_unorm8(destination + i, source + i, count - i);
+    }
+
+    static const pixel_kernels AVX2_KERNELS = {PIXEL_KERNELS_AVX2, avx2_swap_rows, avx2_swizzle_red_blue, avx2_premultiply_alpha, avx2_unorm8_to_float, avx2_float_to_unorm8};
+#endif
+
+#ifdef PCFW_PIXELS_NEON
+    static void neon_swap_rows(unsigned char *a, unsigned char *b, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            uint8x16_t _a = vld1q_u8(a + i);
+            uint8x16_t _b = vld1q_u8(b + i);
+            vst1q_u8(a + i, _b);
+            vst1q_u8(b + i, _a);
+        }
+
+        scalar_swap_rows(a + i, b + i, size - i);
+    }
+
+    static void neon_swizzle_red_blue(unsigned char *destination, const unsigned char *source, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            // The structured load splits the channels, so the swizzle is just swapping two registers
+            uint8x16x4_t _pixels = vld4q_u8(source + i * 4);
+            uint8x16_t _red = _pixels.val[0];
+            _pixels.val[0] = _pixels.val[2];
+            _pixels.val[2] = _red;
+            vst4q_u8(destination + i * 4, _pixels);
+        }
+
+        scalar_swizzle_red_blue(destination + i * 4, source + i * 4, count - i);
+    }
+
+    static inline uint8x16_t neon_premultiply(uint8x16_t channel, uint8x16_t alpha)
+    {
+        uint16x8_t _low = vaddq_u16(vmull_u8(vget_low_u8(channel), vget_low_u8(alpha)), vdupq_n_u16(128));
+        uint16x8_t _high = vaddq_u16(vmull_u8(vget_high_u8(channel), vget_high_u8(alpha)), vdupq_n_u16(128));
+        return vcombine_u8(vshrn_n_u16(vsraq_n_u16(_low, _low, 8), 8), vshrn_n_u16(vsraq_n_u16(_high, _high, 8), 8));
+    }
+
+    static void neon_premultiply_alpha(unsigned char *destination, const unsigned char *source, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t _pixels = vld4q_u8(source + i * 4);
+            _pixels.val[0] = neon_premultiply(_pixels.val[0], _pixels.val[3]);
+            _pixels.val[1] = neon_premultiply(_pixels.val[1], _pixels.val[3]);
+            _pixels.val[2] = neon_premultiply(_pixels.val[2], _pixels.val[3]);
+            vst4q_u8(destination + i * 4, _pixels);
+        }
+
+        scalar_premultiply_alpha(destination + i * 4, source + i * 4, count - i);
+    }
+
+    static void neon_unorm8_to_float(float *destination, const unsigned char *source, size_t count)
+    {
+        const float32x4_t _scale = vdupq_n_f32(UNORM8_SCALE);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16_t _bytes = vld1q_u8(source + i);
+            uint16x8_t _low = vmovl_u8(vget_low_u8(_bytes));
+            uint16x8_t _high = vmovl_u8(vget_high_u8(_bytes));
+
+            vst1q_f32(destination + i, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(_low))), _scale));
+            vst1q_f32(destination + i + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(_low))), _scale));
+            vst1q_f32(destination + i + 8, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(_high))), _scale));
+            vst1q_f32(destination + i + 12, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(_high))), _scale));
+        }
+
+        scalar_unorm8_to_float(destination + i, source + i, count - i);
+    }
+
+    static inline uint16x4_t neon_to_unorm8(const float *source)
+    {
+        // A NaN stays NaN through the min and max, and the conversion makes it 0
+        float32x4_t _value = vminq_f32(vmaxq_f32(vld1q_f32(source), vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+        _value = vaddq_f32(vmulq_f32(_value, vdupq_n_f32(255.0f)), vdupq_n_f32(0.5f));
+        return vmovn_u32(vcvtq_u32_f32(_value));
+    }
+
+    static void neon_float_to_unorm8(unsigned char *destination, const float *source, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x8_t _low = vmovn_u16(vcombine_u16(neon_to_unorm8(source + i), neon_to_unorm8(source + i + 4)));
+            uint8x8_t _high = vmovn_u16(vcombine_u16(neon_to_unorm8(source + i + 8), neon_to_unorm8(source + i + 12)));
+            vst1q_u8(destination + i, vcombine_u8(_low, _high));
+        }
+
+        scalar_float_to_unorm8(destination + i, source + i, count - i);
+    }
+
+    static const pixel_kernels NEON_KERNELS = {PIXEL_KERNELS_NEON, neon_swap_rows, neon_swizzle_red_blue, neon_premultiply_alpha, neon_unorm8_to_float, neon_float_to_unorm8};
+#endif
+
+    // The kernels of `kind`, or nullptr when the CPU doesn't have them
+    static const pixel_kernels *find_kernels(int kind)
+    {
+        switch (kind)
+        {
+        case PIXEL_KERNELS_SCALAR:
+            return &SCALAR_KERNELS;
+#ifdef PCFW_PIXELS_X86
+        case PIXEL_KERNELS_SSE2:
+            return __builtin_cpu_supports("sse2") ? &SSE2_KERNELS : nullptr;
+        case PIXEL_KERNELS_AVX2:
+            return __builtin_cpu_supports("avx2") ? &AVX2_KERNELS : nullptr;
+#endif
+#ifdef PCFW_PIXELS_NEON
+        case PIXEL_KERNELS_NEON:
+            return &NEON_KERNELS;
+#endif
+        default:
+            return nullptr;
+        }
+    }
+
+    static const pixel_kernels *best_kernels()
+    {
+        static const int _order[] = {PIXEL_KERNELS_AVX2, PIXEL_KERNELS_NEON, PIXEL_KERNELS_SSE2};
+
+        for (int _kind : _order)
+        {
+            if (const pixel_kernels *_kernels = find_kernels(_kind))
+            {
+                return _kernels;
+            }
+        }
+
+        return &SCALAR_KERNELS;
+    }
+
+    // Chosen on the first conversion. Threads racing there pick the same table, and the tables are never freed
+    static std::atomic<const pixel_kernels *> _kernels{nullptr};
+
+    static const pixel_kernels &kernels()
+    {
+        const pixel_kernels *_current = _kernels.load(std::memory_order_relaxed);
+        if (!_current)
+        {
+            _current = best_kernels();
+            _kernels.store(_current, std::memory_order_relaxed);
+        }
+
+        return *_current;
+    }
+
+    int get_pixel_kernels()
+    {
+        return kernels()._kind;
+    }
+
+    int set_pixel_kernels(int kernels)
+    {
+        const pixel_kernels *_found = find_kernels(kernels);
+        if (!_found)
+        {
+            return 1;
+        }
+
+        _kernels.store(_found, std::memory_order_relaxed);
+        return 0;
+    }
+
+    void flip_rows(void *pixels, size_t row_size, int height, size_t stride)
+    {
+        unsigned char *_top = static_cast<unsigned char *>(pixels);
+        unsigned char *_bottom = _top + static_cast<size_t>(height > 0 ? height - 1 : 0) * stride;
+        auto _swap_rows = kernels()._swap_rows;
+
+        while (_top < _bottom)
+        {
+            _swap_rows(_top, _bottom, row_size);
+            _top += stride;
+            _bottom -= stride;
+        }
+    }
+
+    void swizzle_red_blue(void *destination, const void *source, size_t count)
+    {
+        kernels()._swizzle_red_blue(static_cast<unsigned char *>(destination), static_cast<const unsigned char *>(source), count);
+    }
+
+    void premultiply_alpha(void *destination, const void *source, size_t count)
+    {
+        kernels()._premultiply_alpha(static_cast<unsigned char *>(destination), static_cast<const unsigned char *>(source), count);
+    }
+
+    void unorm8_to_float(float *destination, const unsigned char *source, size_t count)
+    {
+        kernels()._unorm8_to_float(destination, source, count);
+    }
+
+    void float_to_unorm8(unsigned char *destination, const float *source, size_t count)
+    {
+        kernels()._float_to_unorm8(destination, source, count);
+    }
+} // namespace PCFW
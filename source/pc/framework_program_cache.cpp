@@ -0,0 +1,279 @@
+// Author: oknauta
+// License: MIT
+// File: framework_program_cache.cpp
+// Date: 2026-10-19
+
+#ifdef __linux__
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    // "PCPB", and the layout of `program_header`. Files of other versions are rejected
+    constexpr uint32_t PROGRAM_MAGIC = 0x42504350;
+    constexpr uint32_t PROGRAM_VERSION = 1;
+
+    // What comes before the binary in the files
+    struct program_header
+    {
+        uint32_t _magic;
+        uint32_t _version;
+        // The whole key, the file name alone could collide
+        uint64_t _key;
+        uint32_t _format;
+        uint32_t _size;
+        uint64_t _checksum;
+    };
+
+    // FNV-1a, enough to find changed sources and torn files
+    constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+    constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+    static uint64_t hash(uint64_t hash, const void *data, size_t size)
+    {
+        const unsigned char *_bytes = static_cast<const unsigned char *>(data);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ _bytes[i]) * FNV_PRIME;
+        }
+
+        return hash;
+    }
+
+    // The sizes are hashed too, so moving text from a source to the next one changes the key
+    static uint64_t program_key(const program_cache *cache, const char *const *sources, int count)
+    {
+        uint64_t _key = hash(FNV_OFFSET, &cache->_context_hash, sizeof(cache->_context_hash));
+
+        for (int i = 0; i < count; i++)
+        {
+            uint64_t _size = sources[i] ? strlen(sources[i]) : 0;
+            _key = hash(_key, &_size, sizeof(_size));
+            _key = hash(_key, sources[i], _size);
+        }
+
+        return _key;
+    }
+
+    static std::string program_path(const program_cache *cache, uint64_t key)
+    {
+        char _name[32];
+        snprintf(_name, sizeof(_name), "/%016llx.bin", static_cast<unsigned long long>(key));
+        return cache->_directory + _name;
+    }
+
+    program_cache *INTERNAL_create_program_cache(window *window, const char *directory)
+    {
+        if (window->config._client_api != CLIENT_API_OPENGL)
+        {
+            Log::error("PCFW Internal: The window was created without OpenGL context");
+            return nullptr;
+        }
+
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+
+        if (!_gl._get_string || !_gl._get_integerv || !_gl._get_program_binary || !_gl._program_binary)
+        {
+            Log::error("PCFW Internal: The context has no program binaries");
+            return nullptr;
+        }
+
+        GLint _formats = 0;
+        _gl._get_integerv(GL_NUM_PROGRAM_BINARY_FORMATS, &_formats);
+        if (_formats <= 0)
+        {
+            Log::error("PCFW Internal: The driver has no program binary formats");
+            return nullptr;
+        }
+
+        const char *_renderer = reinterpret_cast<const char *>(_gl._get_string(GL_RENDERER));
+        const char *_version = reinterpret_cast<const char *>(_gl._get_string(GL_VERSION));
+        if (!_renderer || !_version)
+        {
+            Log::error("PCFW Internal: No context is current to create the program cache");
+            return nullptr;
+        }
+
+        if (mkdir(directory, 0755) != 0 && errno != EEXIST)
+        {
+            Log::error("PCFW Internal: Failed to create the program cache directory %s", directory);
+            return nullptr;
+        }
+
+        program_cache *_cache = new program_cache{};
+        _cache->_directory = directory;
+
+        // The version string has the driver version, so updated drivers start with an empty cache
+        _cache->_context_hash = hash(FNV_OFFSET, _renderer, strlen(_renderer) + 1);
+        _cache->_context_hash = hash(_cache->_context_hash, _version, strlen(_version) + 1);
+
+        return _cache;
+    }
+
+    // Checks a mapped file before the driver sees it
+    static bool valid_program(const unsigned char *data, size_t size, uint64_t key)
+    {
+        if (size < sizeof(program_header))
+        {
+            return false;
+        }
+
+        program_header _header;
+        memcpy(&_header, data, sizeof(_header));
+
+        return _header._magic == PROGRAM_MAGIC && _header._version == PROGRAM_VERSION && _header._key == key && _header._size == size - sizeof(program_header) &&
+               _header._checksum == hash(FNV_OFFSET, data + sizeof(program_header), _header._size);
+    }
+
+    unsigned int INTERNAL_program_cache_load(program_cache *cache, const char *const *sources, int count)
+    {
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+
+        uint64_t _key = program_key(cache, sources, count);
+        std::string _path = program_path(cache, _key);
+
+        int _fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (_fd < 0)
+        {
+            return 0;
+        }
+
+        struct stat _stat;
+        if (fstat(_fd, &_stat) != 0 || _stat.st_size <= 0)
+        {
+            close(_fd);
+            return 0;
+        }
+
+        // The driver reads the binary straight from the page cache
+        size_t _size = static_cast<size_t>(_stat.st_size);
+        void *_map = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        close(_fd);
+
+        if (_map == MAP_FAILED)
+        {
+            return 0;
+        }
+
+        const unsigned char *_data = static_cast<const unsigned char *>(_map);
+        GLuint _program = 0;
+
+        if (!valid_program(_data, _size, _key))
+        {
+            Log::warning("PCFW Internal: Removing the corrupt program binary %s", _path.c_str());
+        }
+        else
+        {
+            program_header _header;
+            memcpy(&_header, _data, sizeof(_header));
+
+            _program = _gl._create_program();
+            _gl._program_binary(_program, _header._format, _data + sizeof(program_header), static_cast<GLsizei>(_header._size));
+
+            // Drivers reject binaries they don't like anymore, even with the same version string
+            GLint _linked = GL_FALSE;
+            _gl._get_programiv(_program, GL_LINK_STATUS, &_linked);
+            if (!_linked)
+            {
+                Log::warning("PCFW Internal: The driver rejected the program binary %s", _path.c_str());
+                _gl._delete_program(_program);
+                _program = 0;
+            }
+        }
+
+        munmap(_map, _size);
+
+        if (!_program)
+        {
+            unlink(_path.c_str());
+        }
+
+        return _program;
+    }
+
+    int INTERNAL_program_cache_store(program_cache *cache, const char *const *sources, int count, unsigned int program)
+    {
+        const INTERNAL_gl &_gl = INTERNAL_load_gl();
+
+        GLint _length = 0;
+        _gl._get_programiv(program, GL_PROGRAM_BINARY_LENGTH, &_length);
+        if (_length <= 0)
+        {
+            Log::error("PCFW Internal: The program has no binary");
+            return 1;
+        }
+
+        std::vector<unsigned char> _file(sizeof(program_header) + _length);
+
+        GLsizei _size = 0;
+        GLenum _format = 0;
+        _gl._get_program_binary(program, _length, &_size, &_format, _file.data() + sizeof(program_header));
+        if (_size <= 0)
+        {
+            Log::error("PCFW Internal: Failed to get the program binary");
+            return 1;
+        }
+
+        _file.resize(sizeof(program_header) + _size);
+
+        uint64_t _key = program_key(cache, sources, count);
+
+        program_header _header = {};
+        _header._magic = PROGRAM_MAGIC;
+        _header._version = PROGRAM_VERSION;
+        _header._key = _key;
+        _header._format = _format;
+        _header._size = static_cast<uint32_t>(_size);
+        _header._checksum = hash(FNV_OFFSET, _file.data() + sizeof(program_header), _size);
+        memcpy(_file.data(), &_header, sizeof(_header));
+
+        // Written to a temporary file and renamed, so other processes see the whole file or nothing
+        std::string _temporary = cache->_directory + "/.program-XXXXXX";
+        int _fd = mkostemp(&_temporary[0], O_CLOEXEC);
+        if (_fd < 0)
+        {
+            Log::error("PCFW Internal: Failed to create a file in the program cache");
+            return 1;
+        }
+
+        size_t _written = 0;
+        while (_written < _file.size())
+        {
+            ssize_t _result = write(_fd, _file.data() + _written, _file.size() - _written);
+            if (_result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                break;
+            }
+            _written += static_cast<size_t>(_result);
+        }
+
+        close(_fd);
+
+        if (_written != _file.size() || rename(_temporary.c_str(), program_path(cache, _key).c_str()) != 0)
+        {
+            Log::error("PCFW Internal: Failed to write the program binary");
+            unlink(_temporary.c_str());
+            return 1;
+        }
+
+        return 0;
+    }
+} // namespace PCFW
+
+#endif
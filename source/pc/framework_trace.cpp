@@ -0,0 +1,151 @@
+// Author: oknauta
+// License: MIT
+// File: framework_trace.cpp
+// Date: 2026-10-19
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    // Spans a thread keeps until `write_trace`, the newer ones are dropped when it's full
+    constexpr size_t TRACE_BUFFER_SPANS = 1 << 14;
+
+    struct trace_span
+    {
+        const char *_name;
+        long long _begin;
+        long long _end;
+    };
+
+    // Written only by its thread and read only by `write_trace`, so the positions are enough to share it
+    struct trace_buffer
+    {
+        trace_span _spans[TRACE_BUFFER_SPANS];
+        std::atomic<size_t> _head{0};
+        std::atomic<size_t> _tail{0};
+        std::atomic<unsigned int> _dropped{0};
+        // Set when its thread exits, `write_trace` frees it after writing its last spans
+        std::atomic<bool> _exited{false};
+        int _thread;
+    };
+
+    std::atomic<bool> INTERNAL_tracing{false};
+
+    // Buffers of the threads that have traced. They outlive their threads until they're written
+    static std::mutex _buffers_mutex;
+    static std::vector<std::unique_ptr<trace_buffer>> _buffers;
+    static int _next_thread = 1;
+    static thread_local trace_buffer *_buffer = nullptr;
+    // Spans of the thread_local destructors that run after `_owner` aren't traced
+    static thread_local bool _exiting = false;
+
+    // Only touched when the buffer is made, so the spans don't pay for a thread_local with a destructor
+    struct trace_owner
+    {
+        trace_buffer *_buffer;
+
+        ~trace_owner()
+        {
+            _exiting = true;
+            if (_buffer)
+            {
+                _buffer->_exited.store(true, std::memory_order_release);
+                PC::Framework::_buffer = nullptr;
+            }
+        }
+    };
+
+    static thread_local trace_owner _owner;
+
+    long long INTERNAL_trace_time()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void INTERNAL_trace_span(const char *name, long long begin, long long end)
+    {
+        if (!_buffer)
+        {
+            if (_exiting)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> _lock(_buffers_mutex);
+            _buffers.push_back(std::make_unique<trace_buffer>());
+            _buffer = _buffers.back().get();
+            _buffer->_thread = _next_thread++;
+            _owner._buffer = _buffer;
+        }
+
+        size_t _head = _buffer->_head.load(std::memory_order_relaxed);
+        if (_head - _buffer->_tail.load(std::memory_order_acquire) == TRACE_BUFFER_SPANS)
+        {
+            _buffer->_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        _buffer->_spans[_head % TRACE_BUFFER_SPANS] = {name, begin, end};
+        _buffer->_head.store(_head + 1, std::memory_order_release);
+    }
+
+    int INTERNAL_write_trace(const char *path)
+    {
+        FILE *_file = fopen(path, "w");
+        if (!_file)
+        {
+            Log::error("PCFW Internal: Failed to open the trace file %s", path);
+            return 1;
+        }
+
+        fprintf(_file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+        bool _first = true;
+        std::lock_guard<std::mutex> _lock(_buffers_mutex);
+
+        for (auto _iterator = _buffers.begin(); _iterator != _buffers.end();)
+        {
+            trace_buffer *_thread = _iterator->get();
+
+            // Read before the head, so the spans of an exited thread are all seen
+            bool _exited = _thread->_exited.load(std::memory_order_acquire);
+            size_t _tail = _thread->_tail.load(std::memory_order_relaxed);
+            size_t _head = _thread->_head.load(std::memory_order_acquire);
+
+            // Complete events, the times are in microseconds
+            for (size_t i = _tail; i < _head; i++)
+            {
+                const trace_span &_span = _thread->_spans[i % TRACE_BUFFER_SPANS];
+                fprintf(_file, "%s\n{\"name\":\"%s\",\"cat\":\"pcfw\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", _first ? "" : ",", _span._name, _thread->_thread, _span._begin / 1000.0,
+                        (_span._end - _span._begin) / 1000.0);
+                _first = false;
+            }
+
+            _thread->_tail.store(_head, std::memory_order_release);
+
+            unsigned int _dropped = _thread->_dropped.exchange(0, std::memory_order_relaxed);
+            if (_dropped)
+            {
+                Log::warning("PCFW Internal: %u spans of thread %d were dropped, the trace wasn't written often enough", _dropped, _thread->_thread);
+            }
+
+            _iterator = _exited ? _buffers.erase(_iterator) : _iterator + 1;
+        }
+
+        fprintf(_file, "\n]}\n");
+
+        if (fclose(_file) != 0)
+        {
+            Log::error("PCFW Internal: Failed to write the trace file %s", path);
+            return 1;
+        }
+
+        return 0;
+    }
+} // namespace PCFW
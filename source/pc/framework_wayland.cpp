@@ -0,0 +1,958 @@
+// Author: oknauta
+// License: MIT
+// File: framework_wayland.cpp
+// Date: 2026-10-19
+
+#if defined(__linux__) && defined(PCFW_WAYLAND)
+
+#include "pc/framework.hpp"
+#include "pc/framework_internal.hpp"
+#include <wayland-client-core.h>
+#include <wayland-egl-core.h>
+#include <EGL/egl.h>
+#include <linux/input-event-codes.h>
+#include <dlfcn.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstring>
+#include <ctime>
+
+#include <pc/log.hpp>
+
+namespace PC::Framework
+{
+    // Like the X11 ones, libwayland-client, libwayland-egl and libEGL aren't linked. They're opened by the first Wayland
+    // window, and a machine without them gets X11 windows. The protocol requests are inline functions of the headers
+    // that call `wl_proxy_*`, so the table only has the core functions
+
+#define PCFW_WAYLAND_CLIENT_FUNCTIONS(F) \
+    F(wl_display_cancel_read) \
+    F(wl_display_connect) \
+    F(wl_display_disconnect) \
+    F(wl_display_dispatch) \
+    F(wl_display_dispatch_pending) \
+    F(wl_display_flush) \
+    F(wl_display_get_fd) \
+    F(wl_display_prepare_read) \
+    F(wl_display_read_events) \
+    F(wl_display_roundtrip) \
+    F(wl_proxy_add_listener) \
+    F(wl_proxy_destroy) \
+    F(wl_proxy_get_user_data) \
+    F(wl_proxy_get_version) \
+    F(wl_proxy_marshal) \
+    F(wl_proxy_marshal_constructor) \
+    F(wl_proxy_marshal_constructor_versioned) \
+    F(wl_proxy_marshal_flags) \
+    F(wl_proxy_set_user_data)
+
+#define PCFW_WAYLAND_EGL_FUNCTIONS(F) \
+    F(wl_egl_window_create) \
+    F(wl_egl_window_destroy) \
+    F(wl_egl_window_resize)
+
+#define PCFW_EGL_FUNCTIONS(F) \
+    F(eglBindAPI) \
+    F(eglChooseConfig) \
+    F(eglCreateContext) \
+    F(eglCreateWindowSurface) \
+    F(eglDestroyContext) \
+    F(eglDestroySurface) \
+    F(eglGetDisplay) \
+    F(eglGetProcAddress) \
+    F(eglInitialize) \
+    F(eglMakeCurrent) \
+    F(eglSwapBuffers) \
+    F(eglSwapInterval) \
+    F(eglTerminate)
+
+#define PCFW_WAYLAND_POINTER(name) decltype(&::name) name;
+
+    struct wayland_library
+    {
+        bool _loaded;
+
+        PCFW_WAYLAND_CLIENT_FUNCTIONS(PCFW_WAYLAND_POINTER)
+        PCFW_WAYLAND_EGL_FUNCTIONS(PCFW_WAYLAND_POINTER)
+        PCFW_EGL_FUNCTIONS(PCFW_WAYLAND_POINTER)
+    };
+
+#undef PCFW_WAYLAND_POINTER
+
+    static wayland_library _wayland;
+
+#define PCFW_WAYLAND_RESOLVE(name) _resolved = (_wayland.name = reinterpret_cast<decltype(_wayland.name)>(dlsym(_library, #name))) && _resolved;
+#define PCFW_WAYLAND_LOAD(functions, ...) \
+    [] \
+    { \
+        static const char *const _names[] = {__VA_ARGS__, nullptr}; \
+        void *_library = INTERNAL_open_library(_names); \
+        if (!_library) \
+        { \
+            return false; \
+        } \
+        bool _resolved = true; \
+        functions(PCFW_WAYLAND_RESOLVE) \
+        if (!_resolved) \
+        { \
+            dlclose(_library); \
+        } \
+        return _resolved; \
+    }()
+
+    static bool load_wayland()
+    {
+        if (_wayland._loaded)
+        {
+            return true;
+        }
+
+        if (!PCFW_WAYLAND_LOAD(PCFW_WAYLAND_CLIENT_FUNCTIONS, "libwayland-client.so.0", "libwayland-client.so") ||
+            !PCFW_WAYLAND_LOAD(PCFW_WAYLAND_EGL_FUNCTIONS, "libwayland-egl.so.1", "libwayland-egl.so") || !PCFW_WAYLAND_LOAD(PCFW_EGL_FUNCTIONS, "libEGL.so.1", "libEGL.so"))
+        {
+            PC::Log::error("PCFW Internal: Failed to load libwayland-client, libwayland-egl or libEGL");
+            return false;
+        }
+
+        _wayland._loaded = true;
+
+        return true;
+    }
+
+#undef PCFW_WAYLAND_LOAD
+#undef PCFW_WAYLAND_RESOLVE
+} // namespace PCFW
+
+// From here the Wayland and EGL calls go through `_wayland`, also the ones of the protocol headers
+#define wl_display_cancel_read PC::Framework::_wayland.wl_display_cancel_read
+#define wl_display_connect PC::Framework::_wayland.wl_display_connect
+#define wl_display_disconnect PC::Framework::_wayland.wl_display_disconnect
+#define wl_display_dispatch PC::Framework::_wayland.wl_display_dispatch
+#define wl_display_dispatch_pending PC::Framework::_wayland.wl_display_dispatch_pending
+#define wl_display_flush PC::Framework::_wayland.wl_display_flush
+#define wl_display_get_fd PC::Framework::_wayland.wl_display_get_fd
+#define wl_display_prepare_read PC::Framework::_wayland.wl_display_prepare_read
+#define wl_display_read_events PC::Framework::_wayland.wl_display_read_events
+#define wl_display_roundtrip PC::Framework::_wayland.wl_display_roundtrip
+#define wl_proxy_add_listener PC::Framework::_wayland.wl_proxy_add_listener
+#define wl_proxy_destroy PC::Framework::_wayland.wl_proxy_destroy
+#define wl_proxy_get_user_data PC::Framework::_wayland.wl_proxy_get_user_data
+#define wl_proxy_get_version PC::Framework::_wayland.wl_proxy_get_version
+#define wl_proxy_marshal PC::Framework::_wayland.wl_proxy_marshal
+#define wl_proxy_marshal_constructor PC::Framework::_wayland.wl_proxy_marshal_constructor
+#define wl_proxy_marshal_constructor_versioned PC::Framework::_wayland.wl_proxy_marshal_constructor_versioned
+#define wl_proxy_marshal_flags PC::Framework::_wayland.wl_proxy_marshal_flags
+#define wl_proxy_set_user_data PC::Framework::_wayland.wl_proxy_set_user_data
+#define wl_egl_window_create PC::Framework::_wayland.wl_egl_window_create
+#define wl_egl_window_destroy PC::Framework::_wayland.wl_egl_window_destroy
+#define wl_egl_window_resize PC::Framework::_wayland.wl_egl_window_resize
+#define eglBindAPI PC::Framework::_wayland.eglBindAPI
+#define eglChooseConfig PC::Framework::_wayland.eglChooseConfig
+#define eglCreateContext PC::Framework::_wayland.eglCreateContext
+#define eglCreateWindowSurface PC::Framework::_wayland.eglCreateWindowSurface
+#define eglDestroyContext PC::Framework::_wayland.eglDestroyContext
+#define eglDestroySurface PC::Framework::_wayland.eglDestroySurface
+#define eglGetDisplay PC::Framework::_wayland.eglGetDisplay
+#define eglGetProcAddress PC::Framework::_wayland.eglGetProcAddress
+#define eglInitialize PC::Framework::_wayland.eglInitialize
+#define eglMakeCurrent PC::Framework::_wayland.eglMakeCurrent
+#define eglSwapBuffers PC::Framework::_wayland.eglSwapBuffers
+#define eglSwapInterval PC::Framework::_wayland.eglSwapInterval
+#define eglTerminate PC::Framework::_wayland.eglTerminate
+
+// The interfaces they use are compiled into the framework from `wayland.xml`, see `CMakeLists.txt`
+#include <wayland-client-protocol.h>
+#include "xdg-shell-client-protocol.h"
+
+namespace PC::Framework
+{
+    // How long `WAYLAND_swap_buffers` waits for a frame callback. Hidden surfaces may never receive one
+    constexpr int FRAME_CALLBACK_TIMEOUT = 100;
+
+    struct INTERNAL_wayland_window
+    {
+        wl_display *_display;
+        wl_registry *_registry;
+        wl_compositor *_compositor;
+        xdg_wm_base *_wm_base;
+        wl_seat *_seat;
+        wl_pointer *_pointer;
+        wl_keyboard *_keyboard;
+
+        wl_surface *_surface;
+        xdg_surface *_xdg_surface;
+        xdg_toplevel *_toplevel;
+        wl_callback *_frame_callback;
+
+        wl_egl_window *_egl_window;
+        EGLDisplay _egl_display;
+        EGLConfig _egl_config;
+        EGLContext _egl_context;
+        EGLSurface _egl_surface;
+
+        int _swap_interval;
+        int _pending_width, _pending_height;
+        unsigned int _modifiers;
+        double _cursor_x, _cursor_y;
+        bool _configured;
+        // `WAYLAND_prepare_events` prepared a read that `WAYLAND_check_events` must finish
+        bool _reading;
+    };
+
+    static long elapsed_milliseconds(const timespec &start)
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000;
+    }
+
+    // Finishes a prepared read, waiting at most `timeout` milliseconds for the display.
+    // The gamepads and the eventfd of `request_redraw` are polled together with the display
+    static int read_events(INTERNAL_wayland_window *wayland, int wake_fd, int timeout)
+    {
+        pollfd _fds[2 + GAMEPAD_FD_MAX];
+        _fds[0] = {wl_display_get_fd(wayland->_display), POLLIN, 0};
+        _fds[1] = {wake_fd, POLLIN, 0};
+        int _count = 2 + INTERNAL_gamepad_fds(_fds + 2, GAMEPAD_FD_MAX);
+
+        if (poll(_fds, _count, timeout) > 0 && (_fds[0].revents & POLLIN))
+        {
+            if (wl_display_read_events(wayland->_display) == -1)
+            {
+                return -1;
+            }
+        }
+        else
+        {
+            wl_display_cancel_read(wayland->_display);
+        }
+
+        if (_fds[1].revents & POLLIN)
+        {
+            INTERNAL_clear_wake_fd(wake_fd);
+        }
+
+        INTERNAL_gamepad_process(_fds + 2, _count - 2);
+
+        return wl_display_dispatch_pending(wayland->_display);
+    }
+
+    // Reads and dispatches the events of the display, waiting at most `timeout` milliseconds for them
+    static int dispatch_events(INTERNAL_wayland_window *wayland, int wake_fd, int timeout)
+    {
+        if (wl_display_prepare_read(wayland->_display) != 0)
+        {
+            return wl_display_dispatch_pending(wayland->_display);
+        }
+
+        wl_display_flush(wayland->_display);
+
+        return read_events(wayland, wake_fd, timeout);
+    }
+
+    // Shell
+
+    static void handle_wm_base_ping(void *data, xdg_wm_base *wm_base, uint32_t serial)
+    {
+        xdg_wm_base_pong(wm_base, serial);
+    }
+
+    static void handle_xdg_surface_configure(void *data, xdg_surface *surface, uint32_t serial)
+    {
+        window *_window = static_cast<window *>(data);
+        INTERNAL_wayland_window *wayland = _window->internal._wayland;
+
+        xdg_surface_ack_configure(surface, serial);
+        wayland->_configured = true;
+
+        if (wayland->_pending_width <= 0 || wayland->_pending_height <= 0)
+        {
+            return;
+        }
+
+        if (wayland->_pending_width == _window->config._width && wayland->_pending_height == _window->config._height)
+        {
+            return;
+        }
+
+        _window->config._width = wayland->_pending_width;
+        _window->config._height = wayland->_pending_height;
+
+        if (wayland->_egl_window)
+        {
+            wl_egl_window_resize(wayland->_egl_window, _window->config._width, _window->config._height, 0, 0);
+        }
+
+        if (_window->event._framebuffer_size_callback)
+        {
+            _window->event._framebuffer_size_callback(_window, _window->config._width, _window->config._height);
+        }
+
+        if (_window->event._refresh_callback)
+        {
+            _window->event._refresh_callback(_window);
+        }
+
+        event _event = {};
+        _event.type = EVENT_RESIZE;
+        _event.width = _window->config._width;
+        _event.height = _window->config._height;
+        INTERNAL_post_event(_window, _event);
+    }
+
+    static void handle_toplevel_configure(void *data, xdg_toplevel *toplevel, int32_t width, int32_t height, wl_array *states)
+    {
+        INTERNAL_wayland_window *wayland = static_cast<window *>(data)->internal._wayland;
+
+        // Zero means that the client decides the size
+        wayland->_pending_width = width;
+        wayland->_pending_height = height;
+    }
+
+    static void handle_toplevel_close(void *data, xdg_toplevel *toplevel)
+    {
+        window *_window = static_cast<window *>(data);
+        _window->config._should_close = true;
+
+        event _event = {};
+        _event.type = EVENT_CLOSE;
+        INTERNAL_post_event(_window, _event);
+    }
+
+    // Input
+
+    // Wayland sends every input, the ones that weren't subscribed are dropped here like X11 never selects them
+    static void post_pointer_event(window *window, int type, int active)
+    {
+        if (!(window->config._events & (type == EVENT_MOUSE_MOTION ? EVENTS_MOUSE_MOTION : EVENTS_ENTER_LEAVE)))
+        {
+            return;
+        }
+
+        event _event = {};
+        _event.type = type;
+        _event.x = static_cast<int>(window->internal._wayland->_cursor_x);
+        _event.y = static_cast<int>(window->internal._wayland->_cursor_y);
+        _event.mods = window->internal._wayland->_modifiers;
+        _event.active = active;
+        INTERNAL_post_event(window, _event);
+    }
+
+    static void handle_pointer_enter(void *data, wl_pointer *pointer, uint32_t serial, wl_surface *surface, wl_fixed_t x, wl_fixed_t y)
+    {
+        INTERNAL_wayland_window *wayland = static_cast<window *>(data)->internal._wayland;
+        wayland->_cursor_x = wl_fixed_to_double(x);
+        wayland->_cursor_y = wl_fixed_to_double(y);
+
+        post_pointer_event(static_cast<window *>(data), EVENT_ENTER_LEAVE, 1);
+    }
+
+    static void handle_pointer_leave(void *data, wl_pointer *pointer, uint32_t serial, wl_surface *surface)
+    {
+        post_pointer_event(static_cast<window *>(data), EVENT_ENTER_LEAVE, 0);
+    }
+
+    static void handle_pointer_motion(void *data, wl_pointer *pointer, uint32_t time, wl_fixed_t x, wl_fixed_t y)
+    {
+        INTERNAL_wayland_window *wayland = static_cast<window *>(data)->internal._wayland;
+        wayland->_cursor_x = wl_fixed_to_double(x);
+        wayland->_cursor_y = wl_fixed_to_double(y);
+
+        post_pointer_event(static_cast<window *>(data), EVENT_MOUSE_MOTION, 0);
+    }
+
+    static void handle_pointer_axis(void *data, wl_pointer *pointer, uint32_t time, uint32_t axis, wl_fixed_t value) {}
+    static void handle_pointer_frame(void *data, wl_pointer *pointer) {}
+    static void handle_pointer_axis_source(void *data, wl_pointer *pointer, uint32_t source) {}
+    static void handle_pointer_axis_stop(void *data, wl_pointer *pointer, uint32_t time, uint32_t axis) {}
+    static void handle_pointer_axis_discrete(void *data, wl_pointer *pointer, uint32_t axis, int32_t discrete) {}
+
+    static void handle_pointer_button(void *data, wl_pointer *pointer, uint32_t serial, uint32_t time, uint32_t button, uint32_t state)
+    {
+        window *_window = static_cast<window *>(data);
+
+        // A mouse callback subscribes the buttons, like `event_mask` of the X11 backend
+        if (!(_window->config._events & EVENTS_MOUSE_BUTTON) && !_window->event._mouse_callback)
+        {
+            return;
+        }
+
+        // Same numbers as the X11 backend
+        int _button;
+        switch (button)
+        {
+        case BTN_LEFT:
+            _button = MOUSE_LEFT_BUTTON;
+            break;
+        case BTN_MIDDLE:
+            _button = MOUSE_MIDDLE_BUTTON;
+            break;
+        case BTN_RIGHT:
+            _button = MOUSE_RIGHT_BUTTON;
+            break;
+        default:
+            _button = button - BTN_LEFT + 8;
+            break;
+        }
+
+        int _status = state == WL_POINTER_BUTTON_STATE_PRESSED ? MOUSE_PRESS_BUTTON : MOUSE_RELEASE_BUTTON;
+        if (_window->event._mouse_callback)
+        {
+            _window->event._mouse_callback(_button, _status, _window->internal._wayland->_modifiers);
+        }
+
+        event _event = {};
+        _event.type = EVENT_MOUSE_BUTTON;
+        _event.button = _button;
+        _event.status = _status;
+        _event.mods = _window->internal._wayland->_modifiers;
+        INTERNAL_post_event(_window, _event);
+    }
+
+    static void handle_keyboard_keymap(void *data, wl_keyboard *keyboard, uint32_t format, int32_t fd, uint32_t size)
+    {
+        // The keys are reported as X11 keycodes, no keymap is needed
+        close(fd);
+    }
+
+    static void post_focus_event(window *window, int active)
+    {
+        if (!(window->config._events & EVENTS_FOCUS))
+        {
+            return;
+        }
+
+        event _event = {};
+        _event.type = EVENT_FOCUS;
+        _event.active = active;
+        INTERNAL_post_event(window, _event);
+    }
+
+    static void handle_keyboard_enter(void *data, wl_keyboard *keyboard, uint32_t serial, wl_surface *surface, wl_array *keys)
+    {
+        post_focus_event(static_cast<window *>(data), 1);
+    }
+
+    static void handle_keyboard_leave(void *data, wl_keyboard *keyboard, uint32_t serial, wl_surface *surface)
+    {
+        post_focus_event(static_cast<window *>(data), 0);
+    }
+    static void handle_keyboard_repeat_info(void *data, wl_keyboard *keyboard, int32_t rate, int32_t delay) {}
+
+    static void handle_keyboard_key(void *data, wl_keyboard *keyboard, uint32_t serial, uint32_t time, uint32_t key, uint32_t state)
+    {
+        window *_window = static_cast<window *>(data);
+
+        // A key callback subscribes the keys, like `event_mask` of the X11 backend
+        if (!(_window->config._events & EVENTS_KEY) && !_window->event._key_callback)
+        {
+            return;
+        }
+
+        // evdev codes are 8 lower than the X11 keycodes used by the `KEY_*` constants
+        unsigned int _keycode = key + 8;
+        bool _pressed = state == WL_KEYBOARD_KEY_STATE_PRESSED;
+
+        if (_keycode < 256)
+        {
+            _window->config._key_state[_keycode] = _pressed;
+        }
+
+        if (_window->event._key_callback)
+        {
+            _window->event._key_callback(_keycode, _keycode, _pressed ? KEY_PRESS : KEY_RELEASE, _window->internal._wayland->_modifiers);
+        }
+
+        event _event = {};
+        _event.type = EVENT_KEY;
+        _event.key = _keycode;
+        _event.scancode = _keycode;
+        _event.action = _pressed ? KEY_PRESS : KEY_RELEASE;
+        _event.mods = _window->internal._wayland->_modifiers;
+        INTERNAL_post_event(_window, _event);
+    }
+
+    static void handle_keyboard_modifiers(void *data, wl_keyboard *keyboard, uint32_t serial, uint32_t depressed, uint32_t latched, uint32_t locked, uint32_t group)
+    {
+        static_cast<window *>(data)->internal._wayland->_modifiers = depressed;
+    }
+
+    static void handle_seat_name(void *data, wl_seat *seat, const char *name) {}
+
+    static void handle_seat_capabilities(void *data, wl_seat *seat, uint32_t capabilities)
+    {
+        // The members are set one by one since the listeners grow with the protocol versions. The seat is bound at version 5
+        static wl_pointer_listener _pointer_listener = {};
+        _pointer_listener.enter = handle_pointer_enter;
+        _pointer_listener.leave = handle_pointer_leave;
+        _pointer_listener.motion = handle_pointer_motion;
+        _pointer_listener.button = handle_pointer_button;
+        _pointer_listener.axis = handle_pointer_axis;
+        _pointer_listener.frame = handle_pointer_frame;
+        _pointer_listener.axis_source = handle_pointer_axis_source;
+        _pointer_listener.axis_stop = handle_pointer_axis_stop;
+        _pointer_listener.axis_discrete = handle_pointer_axis_discrete;
+
+        static wl_keyboard_listener _keyboard_listener = {};
+        _keyboard_listener.keymap = handle_keyboard_keymap;
+        _keyboard_listener.enter = handle_keyboard_enter;
+        _keyboard_listener.leave = handle_keyboard_leave;
+        _keyboard_listener.key = handle_keyboard_key;
+        _keyboard_listener.modifiers = handle_keyboard_modifiers;
+        _keyboard_listener.repeat_info = handle_keyboard_repeat_info;
+
+        INTERNAL_wayland_window *wayland = static_cast<window *>(data)->internal._wayland;
+
+        if ((capabilities & WL_SEAT_CAPABILITY_POINTER) && !wayland->_pointer)
+        {
+            wayland->_pointer = wl_seat_get_pointer(seat);
+            wl_pointer_add_listener(wayland->_pointer, &_pointer_listener, data);
+        }
+        else if (!(capabilities & WL_SEAT_CAPABILITY_POINTER) && wayland->_pointer)
+        {
+            wl_pointer_destroy(wayland->_pointer);
+            wayland->_pointer = nullptr;
+        }
+
+        if ((capabilities & WL_SEAT_CAPABILITY_KEYBOARD) && !wayland->_keyboard)
+        {
+            wayland->_keyboard = wl_seat_get_keyboard(seat);
+            wl_keyboard_add_listener(wayland->_keyboard, &_keyboard_listener, data);
+        }
+        else if (!(capabilities & WL_SEAT_CAPABILITY_KEYBOARD) && wayland->_keyboard)
+        {
+            wl_keyboard_destroy(wayland->_keyboard);
+            wayland->_keyboard = nullptr;
+        }
+    }
+
+    // Registry
+
+    static void handle_registry_global(void *data, wl_registry *registry, uint32_t name, const char *interface, uint32_t version)
+    {
+        static xdg_wm_base_listener _wm_base_listener = {};
+        _wm_base_listener.ping = handle_wm_base_ping;
+
+        static wl_seat_listener _seat_listener = {};
+        _seat_listener.capabilities = handle_seat_capabilities;
+        _seat_listener.name = handle_seat_name;
+
+        INTERNAL_wayland_window *wayland = static_cast<window *>(data)->internal._wayland;
+
+        if (strcmp(interface, wl_compositor_interface.name) == 0)
+        {
+            wayland->_compositor = static_cast<wl_compositor *>(wl_registry_bind(registry, name, &wl_compositor_interface, version < 4 ? version : 4));
+        }
+        else if (strcmp(interface, xdg_wm_base_interface.name) == 0)
+        {
+            wayland->_wm_base = static_cast<xdg_wm_base *>(wl_registry_bind(registry, name, &xdg_wm_base_interface, 1));
+            xdg_wm_base_add_listener(wayland->_wm_base, &_wm_base_listener, data);
+        }
+        else if (strcmp(interface, wl_seat_interface.name) == 0 && !wayland->_seat)
+        {
+            wayland->_seat = static_cast<wl_seat *>(wl_registry_bind(registry, name, &wl_seat_interface, version < 5 ? version : 5));
+            wl_seat_add_listener(wayland->_seat, &_seat_listener, data);
+        }
+    }
+
+    static void handle_registry_global_remove(void *data, wl_registry *registry, uint32_t name) {}
+
+    // Frames
+
+    static void handle_frame_done(void *data, wl_callback *callback, uint32_t time)
+    {
+        INTERNAL_wayland_window *wayland = static_cast<window *>(data)->internal._wayland;
+
+        wl_callback_destroy(callback);
+        wayland->_frame_callback = nullptr;
+    }
+
+    // Functions
+
+    int WAYLAND_create_window(window *window)
+    {
+        static wl_registry_listener _registry_listener = {};
+        _registry_listener.global = handle_registry_global;
+        _registry_listener.global_remove = handle_registry_global_remove;
+
+        static xdg_surface_listener _xdg_surface_listener = {};
+        _xdg_surface_listener.configure = handle_xdg_surface_configure;
+
+        static xdg_toplevel_listener _toplevel_listener = {};
+        _toplevel_listener.configure = handle_toplevel_configure;
+        _toplevel_listener.close = handle_toplevel_close;
+
+        // Without the libraries `create_window` falls back to X11
+        if (!load_wayland())
+        {
+            return 1;
+        }
+
+        INTERNAL_wayland_window *wayland = new INTERNAL_wayland_window{};
+        window->internal._wayland = wayland;
+        wayland->_swap_interval = 1;
+
+        // Connecting to the compositor
+        wayland->_display = wl_display_connect(nullptr);
+        if (!wayland->_display)
+        {
+            PC::Log::error("PCFW Internal: Failed to connect to the Wayland display");
+            WAYLAND_destroy_window(window);
+            return 1;
+        }
+
+        // Getting the globals
+        wayland->_registry = wl_display_get_registry(wayland->_display);
+        wl_registry_add_listener(wayland->_registry, &_registry_listener, window);
+        wl_display_roundtrip(wayland->_display);
+
+        if (!wayland->_compositor || !wayland->_wm_base)
+        {
+            PC::Log::error("PCFW Internal: The Wayland compositor has no wl_compositor or xdg_wm_base");
+            WAYLAND_destroy_window(window);
+            return 1;
+        }
+
+        // Creating the surface and its toplevel role
+        wayland->_surface = wl_compositor_create_surface(wayland->_compositor);
+        wayland->_xdg_surface = xdg_wm_base_get_xdg_surface(wayland->_wm_base, wayland->_surface);
+        xdg_surface_add_listener(wayland->_xdg_surface, &_xdg_surface_listener, window);
+
+        wayland->_toplevel = xdg_surface_get_toplevel(wayland->_xdg_surface);
+        xdg_toplevel_add_listener(wayland->_toplevel, &_toplevel_listener, window);
+
+        if (window->config._title)
+        {
+            xdg_toplevel_set_title(wayland->_toplevel, window->config._title);
+        }
+
+        // The first commit without a buffer asks for the first configure
+        wl_surface_commit(wayland->_surface);
+        while (!wayland->_configured)
+        {
+            if (wl_display_dispatch(wayland->_display) == -1)
+            {
+                PC::Log::error("PCFW Internal: Lost the Wayland display while configuring the window");
+                WAYLAND_destroy_window(window);
+                return 1;
+            }
+        }
+
+        // Setting EGL up
+        wayland->_egl_display = eglGetDisplay(reinterpret_cast<EGLNativeDisplayType>(wayland->_display));
+        if (wayland->_egl_display == EGL_NO_DISPLAY || !eglInitialize(wayland->_egl_display, nullptr, nullptr))
+        {
+            PC::Log::error("PCFW Internal: Failed to initialize EGL");
+            WAYLAND_destroy_window(window);
+            return 1;
+        }
+
+        eglBindAPI(EGL_OPENGL_API);
+
+        // The same attributes of the GLX visual
+        static const EGLint _attributes[]
+        {
+            EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_DEPTH_SIZE, 24,
+            EGL_NONE
+        };
+
+        EGLint _count = 0;
+        if (!eglChooseConfig(wayland->_egl_display, _attributes, &wayland->_egl_config, 1, &_count) || _count == 0)
+        {
+            PC::Log::error("PCFW Internal: Failed to choose EGL config");
+            WAYLAND_destroy_window(window);
+            return 1;
+        }
+
+        wayland->_egl_context = eglCreateContext(wayland->_egl_display, wayland->_egl_config, EGL_NO_CONTEXT, nullptr);
+        if (wayland->_egl_context == EGL_NO_CONTEXT)
+        {
+            PC::Log::error("PCFW Internal: Failed to create EGL context");
+            WAYLAND_destroy_window(window);
+            return 1;
+        }
+
+        if (wayland->_pending_width > 0 && wayland->_pending_height > 0)
+        {
+            window->config._width = wayland->_pending_width;
+            window->config._height = wayland->_pending_height;
+        }
+
+        wayland->_egl_window = wl_egl_window_create(wayland->_surface, window->config._width, window->config._height);
+        wayland->_egl_surface = eglCreateWindowSurface(wayland->_egl_display, wayland->_egl_config, reinterpret_cast<EGLNativeWindowType>(wayland->_egl_window), nullptr);
+        if (wayland->_egl_surface == EGL_NO_SURFACE)
+        {
+            PC::Log::error("PCFW Internal: Failed to create EGL surface");
+            WAYLAND_destroy_window(window);
+            return 1;
+        }
+
+        return 0;
+    }
+
+    int WAYLAND_destroy_window(window *window)
+    {
+        INTERNAL_wayland_window *wayland = window->internal._wayland;
+        if (!wayland)
+        {
+            return 0;
+        }
+
+        if (wayland->_egl_display != EGL_NO_DISPLAY && wayland->_egl_display)
+        {
+            eglMakeCurrent(wayland->_egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+            if (wayland->_egl_surface && wayland->_egl_surface != EGL_NO_SURFACE)
+            {
+                eglDestroySurface(wayland->_egl_display, wayland->_egl_surface);
+            }
+
+            if (wayland->_egl_context && wayland->_egl_context != EGL_NO_CONTEXT)
+            {
+                eglDestroyContext(wayland->_egl_display, wayland->_egl_context);
+            }
+
+            eglTerminate(wayland->_egl_display);
+        }
+
+        if (wayland->_egl_window)
+        {
+            wl_egl_window_destroy(wayland->_egl_window);
+        }
+
+        if (wayland->_frame_callback)
+        {
+            wl_callback_destroy(wayland->_frame_callback);
+        }
+
+        if (wayland->_toplevel)
+        {
+            xdg_toplevel_destroy(wayland->_toplevel);
+        }
+
+        if (wayland->_xdg_surface)
+        {
+            xdg_surface_destroy(wayland->_xdg_surface);
+        }
+
+        if (wayland->_surface)
+        {
+            wl_surface_destroy(wayland->_surface);
+        }
+
+        if (wayland->_pointer)
+        {
+            wl_pointer_destroy(wayland->_pointer);
+        }
+
+        if (wayland->_keyboard)
+        {
+            wl_keyboard_destroy(wayland->_keyboard);
+        }
+
+        if (wayland->_seat)
+        {
+            wl_seat_destroy(wayland->_seat);
+        }
+
+        if (wayland->_wm_base)
+        {
+            xdg_wm_base_destroy(wayland->_wm_base);
+        }
+
+        if (wayland->_compositor)
+        {
+            wl_compositor_destroy(wayland->_compositor);
+        }
+
+        if (wayland->_registry)
+        {
+            wl_registry_destroy(wayland->_registry);
+        }
+
+        if (wayland->_display)
+        {
+            wl_display_disconnect(wayland->_display);
+        }
+
+        delete wayland;
+        window->internal._wayland = nullptr;
+
+        return 0;
+    }
+
+    int WAYLAND_make_context_current(window *window)
+    {
+        INTERNAL_wayland_window *wayland = window->internal._wayland;
+
+        if (!eglMakeCurrent(wayland->_egl_display, wayland->_egl_surface, wayland->_egl_surface, wayland->_egl_context))
+        {
+            PC::Log::error("PCFW Internal: Failed to make context current");
+            return 1;
+        }
+
+        // The swaps are throttled by `wl_surface.frame`, EGL must not block too
+        eglSwapInterval(wayland->_egl_display, 0);
+
+        return 0;
+    }
+
+    void WAYLAND_poll_events(window *window)
+    {
+        if (dispatch_events(window->internal._wayland, window->internal._wake_fd, 0) == -1)
+        {
+            PC::Log::error("PCFW Internal: Lost the Wayland display");
+            window->config._should_close = true;
+        }
+    }
+
+    void WAYLAND_wait_events(window *window, int timeout)
+    {
+        if (dispatch_events(window->internal._wayland, window->internal._wake_fd, timeout) == -1)
+        {
+            PC::Log::error("PCFW Internal: Lost the Wayland display");
+            window->config._should_close = true;
+        }
+    }
+
+    int WAYLAND_get_event_fd(window *window)
+    {
+        return wl_display_get_fd(window->internal._wayland->_display);
+    }
+
+    void WAYLAND_dispatch_pending(window *window)
+    {
+        if (wl_display_dispatch_pending(window->internal._wayland->_display) == -1)
+        {
+            PC::Log::error("PCFW Internal: Lost the Wayland display");
+            window->config._should_close = true;
+        }
+    }
+
+    int WAYLAND_prepare_events(window *window)
+    {
+        INTERNAL_wayland_window *wayland = window->internal._wayland;
+
+        if (wayland->_reading)
+        {
+            return 0;
+        }
+
+        // Events are queued already, the loop mustn't sleep
+        if (wl_display_prepare_read(wayland->_display) != 0)
+        {
+            return 1;
+        }
+
+        wl_display_flush(wayland->_display);
+        wayland->_reading = true;
+
+        return 0;
+    }
+
+    void WAYLAND_check_events(window *window)
+    {
+        INTERNAL_wayland_window *wayland = window->internal._wayland;
+
+        int _result;
+        if (wayland->_reading)
+        {
+            wayland->_reading = false;
+            _result = read_events(wayland, window->internal._wake_fd, 0);
+        }
+        else
+        {
+            _result = dispatch_events(wayland, window->internal._wake_fd, 0);
+        }
+
+        if (_result == -1)
+        {
+            PC::Log::error("PCFW Internal: Lost the Wayland display");
+            window->config._should_close = true;
+        }
+    }
+
+    void WAYLAND_swap_buffers(window *window)
+    {
+        static const wl_callback_listener _frame_listener = {handle_frame_done};
+
+        INTERNAL_wayland_window *wayland = window->internal._wayland;
+
+        // Waiting until the compositor asks for a new frame
+        if (wayland->_frame_callback)
+        {
+            timespec _start;
+            clock_gettime(CLOCK_MONOTONIC, &_start);
+
+            // The redraws don't cut this wait short, poll ignores the negative fd
+            while (wayland->_frame_callback)
+            {
+                long _remaining = FRAME_CALLBACK_TIMEOUT - elapsed_milliseconds(_start);
+                if (_remaining <= 0 || dispatch_events(wayland, -1, static_cast<int>(_remaining)) == -1)
+                {
+                    break;
+                }
+            }
+        }
+
+        // Commited by `eglSwapBuffers`
+        if (wayland->_swap_interval > 0 && !wayland->_frame_callback)
+        {
+            wayland->_frame_callback = wl_surface_frame(wayland->_surface);
+            wl_callback_add_listener(wayland->_frame_callback, &_frame_listener, window);
+        }
+
+        eglSwapBuffers(wayland->_egl_display, wayland->_egl_surface);
+    }
+
+    void WAYLAND_set_swap_interval(window *window, int interval)
+    {
+        window->internal._wayland->_swap_interval = interval;
+    }
+
+    void WAYLAND_set_window_limits(window *window, int minimum_width, int minimum_height, int maximum_width, int maximum_height)
+    {
+        INTERNAL_wayland_window *wayland = window->internal._wayland;
+
+        // Zero is "no limit" for xdg-shell
+        xdg_toplevel_set_min_size(wayland->_toplevel, minimum_width > 0 ? minimum_width : 0, minimum_height > 0 ? minimum_height : 0);
+        xdg_toplevel_set_max_size(wayland->_toplevel, maximum_width > 0 ? maximum_width : 0, maximum_height > 0 ? maximum_height : 0);
+        wl_surface_commit(wayland->_surface);
+    }
+
+    int WAYLAND_get_cursor_position(window *window, int *x, int *y)
+    {
+        // Wayland has no pointer query, the position comes from the last pointer events
+        if (x)
+        {
+            *x = static_cast<int>(window->internal._wayland->_cursor_x);
+        }
+
+        if (y)
+        {
+            *y = static_cast<int>(window->internal._wayland->_cursor_y);
+        }
+
+        return 0;
+    }
+
+    void *WAYLAND_get_proc_address(const char *proc)
+    {
+        void *_address = reinterpret_cast<void *>(eglGetProcAddress(proc));
+
+        if (!_address)
+        {
+            Log::error("Failed to load proc");
+            return nullptr;
+        }
+
+        return _address;
+    }
+} // namespace PCFW
+
+#endif
@@ -0,0 +1,93 @@
+// Author: oknauta
+// License: MIT
+// File: command_buffer_window.cpp
+// Date: 2026-10-19
+
+// Worker threads record command buffers without a context, `swap_buffers` replays them.
+// Each worker changes the viewport to its own quarter of the window and clears it
+
+#include <pc/framework.hpp>
+#include <pc/log.hpp>
+#include <GL/gl.h>
+#include <thread>
+#include <vector>
+
+constexpr int WORKERS = 4;
+
+struct quarter
+{
+	int x, y, width, height;
+	float red;
+};
+
+void clear_quarter(void *user_data)
+{
+	quarter *area = static_cast<quarter *>(user_data);
+
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(area->x, area->y, area->width, area->height);
+	glClearColor(area->red, 0.2f, 0.3f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+	glDisable(GL_SCISSOR_TEST);
+}
+
+int main()
+{
+	PC::Framework::window *window = PC::Framework::create_window(800, 600, "Command buffers");
+	if (!window)
+	{
+		PC::Log::error("Failed to create window");
+		return 1;
+	}
+
+	PC::Framework::make_context_current(window);
+
+	PC::Framework::command_buffer *buffers[WORKERS];
+	quarter quarters[WORKERS];
+	for (int i = 0; i < WORKERS; i++)
+	{
+		buffers[i] = PC::Framework::create_command_buffer();
+	}
+
+	int frames = 0;
+
+	while (!PC::Framework::window_should_close(window))
+	{
+		PC::Framework::poll_events(window);
+
+		int width = PC::Framework::get_window_width(window);
+		int height = PC::Framework::get_window_height(window);
+
+		std::vector<std::thread> workers;
+		for (int i = 0; i < WORKERS; i++)
+		{
+			workers.emplace_back([&, i] {
+				quarter &area = quarters[i];
+				area = {(i % 2) * width / 2, (i / 2) * height / 2, width / 2, height / 2, ((frames + i * 15) % 60) / 60.0f};
+
+				PC::Framework::reset_command_buffer(buffers[i]);
+				PC::Framework::command_viewport(buffers[i], area.x, area.y, area.width, area.height);
+				PC::Framework::command_callback(buffers[i], clear_quarter, &area);
+			});
+		}
+
+		// Submitted in a fixed order, so the replay order doesn't depend on the workers
+		for (int i = 0; i < WORKERS; i++)
+		{
+			workers[i].join();
+			PC::Framework::submit_command_buffer(window, buffers[i]);
+		}
+
+		PC::Framework::swap_buffers(window);
+		frames++;
+	}
+
+	for (int i = 0; i < WORKERS; i++)
+	{
+		PC::Framework::destroy_command_buffer(buffers[i]);
+	}
+
+	PC::Framework::destroy_window(window);
+
+	return 0;
+}
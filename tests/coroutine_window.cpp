@@ -0,0 +1,53 @@
+// Author: oknauta
+// License: MIT
+// File: coroutine_window.cpp
+// Date: 2026-10-19
+
+// Needs C++20 and pcfw built with -DPCFW_COROUTINES=ON
+
+#include <pc/framework.hpp>
+#include <pc/framework_coroutine.hpp>
+#include <pc/log.hpp>
+
+// A flow that would be a state machine in the loop
+PC::Framework::task greet(PC::Framework::window *window)
+{
+	PC::Log::info("Click the window");
+
+	PC::Framework::event event = co_await PC::Framework::next_event(window, PC::Framework::EVENT_MOUSE_BUTTON);
+	PC::Log::info("Button %d clicked", event.button);
+
+	co_await PC::Framework::wait_timeout(window, 1.0);
+	PC::Log::info("One second later");
+
+	for (int i = 0; i < 60; i++)
+	{
+		co_await PC::Framework::next_frame(window);
+	}
+	PC::Log::info("60 frames later");
+}
+
+int main()
+{
+	PC::Framework::window *window = PC::Framework::create_window(800, 600, "Coroutines");
+	if (!window)
+	{
+		PC::Log::error("Failed to create window");
+		return 1;
+	}
+
+	PC::Framework::make_context_current(window);
+
+	greet(window);
+
+	// The same loop resumes the coroutines
+	while (!PC::Framework::window_should_close(window))
+	{
+		PC::Framework::poll_events(window);
+		PC::Framework::swap_buffers(window);
+	}
+
+	PC::Framework::destroy_window(window);
+
+	return 0;
+}
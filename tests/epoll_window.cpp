@@ -0,0 +1,70 @@
+// Author: oknauta
+// License: MIT
+// File: epoll_window.cpp
+// Date: 2026-10-19
+
+// A window inside an epoll loop, without `poll_events`
+
+#include <pc/framework.hpp>
+#include <pc/log.hpp>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <algorithm>
+
+int main()
+{
+	PC::Framework::window *window = PC::Framework::create_window(800, 600, "epoll");
+	if (!window)
+	{
+		PC::Log::error("Failed to create window");
+		return 1;
+	}
+
+	int epoll = epoll_create1(EPOLL_CLOEXEC);
+
+	// The display, `request_redraw` and the gamepads. Gamepads come and go, so the set is checked every time
+	int fds[PC::Framework::EVENT_FD_MAX];
+	int count = 0;
+
+	while (!PC::Framework::window_should_close(window))
+	{
+		int current[PC::Framework::EVENT_FD_MAX];
+		int current_count = PC::Framework::get_event_fds(window, current, PC::Framework::EVENT_FD_MAX);
+
+		if (current_count != count || !std::equal(current, current + count, fds))
+		{
+			for (int i = 0; i < count; i++)
+			{
+				epoll_ctl(epoll, EPOLL_CTL_DEL, fds[i], nullptr);
+			}
+
+			for (int i = 0; i < current_count; i++)
+			{
+				epoll_event event = {};
+				event.events = EPOLLIN;
+				epoll_ctl(epoll, EPOLL_CTL_ADD, current[i], &event);
+				fds[i] = current[i];
+			}
+
+			count = current_count;
+		}
+
+		// Events read by other calls don't wake the fd up
+		if (PC::Framework::prepare_events(window))
+		{
+			PC::Framework::dispatch_pending(window);
+			continue;
+		}
+
+		// The other sources of the loop would be waited here too
+		epoll_event ready;
+		epoll_wait(epoll, &ready, 1, -1);
+
+		PC::Framework::check_events(window);
+	}
+
+	close(epoll);
+	PC::Framework::destroy_window(window);
+
+	return 0;
+}
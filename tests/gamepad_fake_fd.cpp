@@ -0,0 +1,115 @@
+// Author: oknauta
+// License: MIT
+// File: gamepad_fake_fd.cpp
+// Date: 2026-10-19
+
+// A gamepad without a device. The read end of a pipe is attached as an evdev fd and the test writes the events
+// a gamepad would send, then checks the snapshots
+
+#include <pc/framework.hpp>
+#include <pc/framework_internal.hpp>
+#include <pc/log.hpp>
+#include <linux/input.h>
+#include <poll.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+static void check(bool condition, const char *what)
+{
+	if (!condition)
+	{
+		PC::Log::error("Failed: %s", what);
+		failures++;
+	}
+}
+
+static void send(int fd, unsigned short type, unsigned short code, int value)
+{
+	input_event event = {};
+	event.type = type;
+	event.code = code;
+	event.value = value;
+
+	if (write(fd, &event, sizeof(event)) != sizeof(event))
+	{
+		PC::Log::error("Failed to write the event");
+	}
+}
+
+// What `poll_events` does with the gamepads, without a window
+static void process()
+{
+	pollfd fds[PC::Framework::GAMEPAD_FD_MAX];
+	int count = PC::Framework::INTERNAL_gamepad_fds(fds, PC::Framework::GAMEPAD_FD_MAX);
+
+	poll(fds, count, 0);
+	PC::Framework::INTERNAL_gamepad_process(fds, count);
+}
+
+static PC::Framework::gamepad_state state_of(int gamepad)
+{
+	PC::Framework::gamepad_state state;
+	PC::Framework::get_gamepad_state(gamepad, &state);
+	return state;
+}
+
+int main()
+{
+	int pipe_fds[2];
+	if (pipe(pipe_fds) != 0)
+	{
+		PC::Log::error("Failed to create the pipe");
+		return 1;
+	}
+
+	int gamepad = PC::Framework::INTERNAL_gamepad_attach_fd(pipe_fds[0], "Fake gamepad");
+	check(gamepad >= 0, "the fd is attached");
+	if (gamepad < 0)
+	{
+		return 1;
+	}
+
+	check(state_of(gamepad).connected, "the gamepad is connected");
+
+	// Nothing is seen until the report is complete
+	send(pipe_fds[1], EV_KEY, BTN_SOUTH, 1);
+	send(pipe_fds[1], EV_ABS, ABS_X, 32767);
+	process();
+	check(!state_of(gamepad).buttons[PC::Framework::GAMEPAD_BUTTON_SOUTH], "a report without SYN_REPORT isn't visible");
+
+	send(pipe_fds[1], EV_SYN, SYN_REPORT, 0);
+	process();
+	PC::Framework::gamepad_state state = state_of(gamepad);
+	check(state.buttons[PC::Framework::GAMEPAD_BUTTON_SOUTH], "the button is pressed");
+	check(state.axes[PC::Framework::GAMEPAD_AXIS_LEFT_X] > 0.99f, "the axis is at its maximum");
+
+	send(pipe_fds[1], EV_KEY, BTN_SOUTH, 0);
+	send(pipe_fds[1], EV_SYN, SYN_REPORT, 0);
+	process();
+	check(!state_of(gamepad).buttons[PC::Framework::GAMEPAD_BUTTON_SOUTH], "the button is released");
+
+	// After a drop the rest of the report is stale and skipped
+	send(pipe_fds[1], EV_SYN, SYN_DROPPED, 0);
+	send(pipe_fds[1], EV_KEY, BTN_EAST, 1);
+	send(pipe_fds[1], EV_SYN, SYN_REPORT, 0);
+	process();
+	check(!state_of(gamepad).buttons[PC::Framework::GAMEPAD_BUTTON_EAST], "the events after SYN_DROPPED are skipped");
+
+	send(pipe_fds[1], EV_KEY, BTN_EAST, 1);
+	send(pipe_fds[1], EV_SYN, SYN_REPORT, 0);
+	process();
+	check(state_of(gamepad).buttons[PC::Framework::GAMEPAD_BUTTON_EAST], "the reports after the drop are seen again");
+
+	// Closing the write end is what unplugging is for a pipe
+	close(pipe_fds[1]);
+	process();
+	check(!state_of(gamepad).connected, "the gamepad is disconnected");
+
+	if (failures == 0)
+	{
+		PC::Log::info("The fake gamepad behaved like a device");
+	}
+
+	return failures == 0 ? 0 : 1;
+}
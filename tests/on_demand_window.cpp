@@ -0,0 +1,62 @@
+// Author: oknauta
+// License: MIT
+// File: on_demand_window.cpp
+// Date: 2026-10-19
+
+// A window drawn only when something changed. Between changes it sleeps in `wait_events`.
+// Another thread asks for a redraw every second, like a clock would
+
+#include <pc/framework.hpp>
+#include <pc/log.hpp>
+#include <GL/gl.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+int main()
+{
+	PC::Framework::window *window = PC::Framework::create_window(800, 600, "On demand");
+	if (!window)
+	{
+		PC::Log::error("Failed to create window");
+		return 1;
+	}
+
+	PC::Framework::make_context_current(window);
+	PC::Framework::subscribe_events(window, PC::Framework::EVENTS_KEY | PC::Framework::EVENTS_MOUSE_BUTTON);
+
+	std::atomic<bool> running{true};
+	std::thread ticker([&] {
+		while (running)
+		{
+			std::this_thread::sleep_for(std::chrono::seconds(1));
+			PC::Framework::request_redraw(window);
+		}
+	});
+
+	int frames = 0;
+
+	while (!PC::Framework::window_should_close(window))
+	{
+		PC::Framework::wait_events(window);
+
+		if (!PC::Framework::needs_redraw(window))
+		{
+			continue;
+		}
+
+		frames++;
+		glClearColor((frames % 10) / 10.0f, 0.2f, 0.3f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		PC::Framework::swap_buffers(window);
+
+		PC::Log::info("Frame %d", frames);
+	}
+
+	running = false;
+	ticker.join();
+
+	PC::Framework::destroy_window(window);
+
+	return 0;
+}
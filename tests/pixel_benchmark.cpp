@@ -0,0 +1,135 @@
+// Author: oknauta
+// License: MIT
+// File: pixel_benchmark.cpp
+// Date: 2026-10-19
+
+// Checks every pixel kernel the CPU has against the scalar one, then times them.
+// ./pixel_benchmark 1920 1080
+
+#include <pc/framework_pixels.hpp>
+#include <pc/log.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+constexpr int ROUNDS = 20;
+
+const char *kernel_name(int kernels)
+{
+	switch (kernels)
+	{
+	case PC::Framework::PIXEL_KERNELS_SSE2:
+		return "SSE2";
+	case PC::Framework::PIXEL_KERNELS_AVX2:
+		return "AVX2";
+	case PC::Framework::PIXEL_KERNELS_NEON:
+		return "NEON";
+	default:
+		return "scalar";
+	}
+}
+
+struct images
+{
+	std::vector<unsigned char> bytes;
+	std::vector<unsigned char> result;
+	std::vector<float> floats;
+};
+
+// Everything the conversions produce, so two kernels can be compared byte by byte
+std::vector<unsigned char> convert_all(images &images, int width, int height)
+{
+	size_t pixels = static_cast<size_t>(width) * height;
+	std::vector<unsigned char> output;
+
+	images.result = images.bytes;
+	PC::Framework::flip_rows(images.result.data(), width * 4, height, width * 4);
+	output.insert(output.end(), images.result.begin(), images.result.end());
+
+	PC::Framework::swizzle_red_blue(images.result.data(), images.bytes.data(), pixels);
+	output.insert(output.end(), images.result.begin(), images.result.end());
+
+	PC::Framework::premultiply_alpha(images.result.data(), images.bytes.data(), pixels);
+	output.insert(output.end(), images.result.begin(), images.result.end());
+
+	PC::Framework::unorm8_to_float(images.floats.data(), images.bytes.data(), pixels * 4);
+	const unsigned char *floats = reinterpret_cast<const unsigned char *>(images.floats.data());
+	output.insert(output.end(), floats, floats + pixels * 4 * sizeof(float));
+
+	// Out of range values and NaN have to be clamped the same way too
+	images.floats[0] = -1.0f;
+	images.floats[1] = 2.0f;
+	images.floats[2] = std::nanf("");
+	PC::Framework::float_to_unorm8(images.result.data(), images.floats.data(), pixels * 4);
+	output.insert(output.end(), images.result.begin(), images.result.end());
+
+	return output;
+}
+
+// Milliseconds of one round of `convert`
+template <typename function>
+double time_rounds(function convert)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < ROUNDS; i++)
+	{
+		convert();
+	}
+
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+int main(int argc, char **argv)
+{
+	// Odd sizes, so the scalar tails after the vectors run too
+	int width = argc > 1 ? atoi(argv[1]) : 1921;
+	int height = argc > 2 ? atoi(argv[2]) : 1081;
+	size_t pixels = static_cast<size_t>(width) * height;
+
+	images images;
+	images.bytes.resize(pixels * 4);
+	images.floats.resize(pixels * 4);
+
+	srand(1);
+	for (unsigned char &byte : images.bytes)
+	{
+		byte = static_cast<unsigned char>(rand());
+	}
+
+	PC::Framework::set_pixel_kernels(PC::Framework::PIXEL_KERNELS_SCALAR);
+	std::vector<unsigned char> expected = convert_all(images, width, height);
+
+	int result = 0;
+
+	for (int kernels = PC::Framework::PIXEL_KERNELS_SCALAR; kernels <= PC::Framework::PIXEL_KERNELS_NEON; kernels++)
+	{
+		if (PC::Framework::set_pixel_kernels(kernels) != 0)
+		{
+			continue;
+		}
+
+		if (convert_all(images, width, height) != expected)
+		{
+			PC::Log::error("The %s kernels differ from the scalar ones", kernel_name(kernels));
+			result = 1;
+			continue;
+		}
+
+		double flip = time_rounds([&] { PC::Framework::flip_rows(images.result.data(), width * 4, height, width * 4); });
+		double swizzle = time_rounds([&] { PC::Framework::swizzle_red_blue(images.result.data(), images.bytes.data(), pixels); });
+		double premultiply = time_rounds([&] { PC::Framework::premultiply_alpha(images.result.data(), images.bytes.data(), pixels); });
+		double to_float = time_rounds([&] { PC::Framework::unorm8_to_float(images.floats.data(), images.bytes.data(), pixels * 4); });
+		double to_unorm8 = time_rounds([&] { PC::Framework::float_to_unorm8(images.result.data(), images.floats.data(), pixels * 4); });
+
+		PC::Log::info("%-6s flip %.3f ms, swizzle %.3f ms, premultiply %.3f ms, to float %.3f ms, to unorm8 %.3f ms", kernel_name(kernels), flip, swizzle, premultiply, to_float, to_unorm8);
+	}
+
+	if (result == 0)
+	{
+		PC::Log::info("Every kernel matches the scalar one on %dx%d pixels", width, height);
+	}
+
+	return result;
+}
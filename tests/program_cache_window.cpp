@@ -0,0 +1,162 @@
+// Author: oknauta
+// License: MIT
+// File: program_cache_window.cpp
+// Date: 2026-10-19
+
+// Links a program, stores it and opens the cache again like the next run of a program would. The second cache
+// must load the binary without compiling, and a corrupt file must be rejected and removed
+
+#include <glad/glad.h>
+#include <pc/framework.hpp>
+#include <pc/log.hpp>
+#include <dirent.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+static const char *vertex_source =
+	"#version 330 core\n"
+	"void main() { gl_Position = vec4(0.0, 0.0, 0.0, 1.0); }\n";
+
+static const char *fragment_source =
+	"#version 330 core\n"
+	"out vec4 color;\n"
+	"void main() { color = vec4(1.0, 0.5, 0.2, 1.0); }\n";
+
+static int failures = 0;
+
+static void check(bool condition, const char *what)
+{
+	if (!condition)
+	{
+		PC::Log::error("Failed: %s", what);
+		failures++;
+	}
+}
+
+static GLuint compile(GLenum type, const char *source)
+{
+	GLuint shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, nullptr);
+	glCompileShader(shader);
+	return shader;
+}
+
+static GLuint link_program()
+{
+	GLuint vertex = compile(GL_VERTEX_SHADER, vertex_source);
+	GLuint fragment = compile(GL_FRAGMENT_SHADER, fragment_source);
+
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(program);
+
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+
+	GLint linked = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	return linked ? program : 0;
+}
+
+// The cache has a single binary, named after its key
+static std::string binary_path(const std::string &directory)
+{
+	std::string path;
+
+	DIR *dir = opendir(directory.c_str());
+	while (dirent *entry = dir ? readdir(dir) : nullptr)
+	{
+		if (entry->d_name[0] != '.')
+		{
+			path = directory + "/" + entry->d_name;
+		}
+	}
+
+	if (dir)
+	{
+		closedir(dir);
+	}
+
+	return path;
+}
+
+int main()
+{
+	PC::Framework::window *window = PC::Framework::create_window(320, 240, "Program cache");
+	if (!window)
+	{
+		PC::Log::error("Failed to create window");
+		return 1;
+	}
+
+	PC::Framework::make_context_current(window);
+
+	if (!gladLoadGLLoader(PC::Framework::get_proc_address))
+	{
+		PC::Log::error("Failed to initialize GLAD");
+		return 1;
+	}
+
+	char directory[] = "/tmp/pcfw-program-cache-XXXXXX";
+	if (!mkdtemp(directory))
+	{
+		PC::Log::error("Failed to create the cache directory");
+		return 1;
+	}
+
+	const char *sources[] = {vertex_source, fragment_source};
+
+	// First run, nothing is cached
+	PC::Framework::program_cache *cache = PC::Framework::create_program_cache(window, directory);
+	if (!cache)
+	{
+		PC::Log::warning("The driver has no program binaries, nothing to test");
+		rmdir(directory);
+		return 0;
+	}
+
+	check(PC::Framework::program_cache_load(cache, sources, 2) == 0, "an empty cache has no program");
+
+	GLuint program = link_program();
+	check(program != 0, "the program links");
+	check(PC::Framework::program_cache_store(cache, sources, 2, program) == 0, "the program is stored");
+	glDeleteProgram(program);
+	PC::Framework::destroy_program_cache(cache);
+
+	// Second run, the binary is loaded
+	cache = PC::Framework::create_program_cache(window, directory);
+	program = PC::Framework::program_cache_load(cache, sources, 2);
+	check(program != 0, "the second run loads the program from the cache");
+	glDeleteProgram(program);
+
+	// A flipped byte in the binary fails its checksum
+	std::string path = binary_path(directory);
+	check(!path.empty(), "the binary is on disk");
+
+	if (FILE *file = fopen(path.c_str(), "r+b"))
+	{
+		fseek(file, -1, SEEK_END);
+		int byte = fgetc(file);
+		fseek(file, -1, SEEK_END);
+		fputc(byte ^ 0xff, file);
+		fclose(file);
+	}
+
+	check(PC::Framework::program_cache_load(cache, sources, 2) == 0, "a corrupt binary is rejected");
+	check(access(path.c_str(), F_OK) != 0, "the corrupt binary is removed");
+
+	PC::Framework::destroy_program_cache(cache);
+	rmdir(directory);
+	PC::Framework::destroy_window(window);
+
+	if (failures == 0)
+	{
+		PC::Log::info("The program cache loaded its binary and rejected the corrupt one");
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+// Author: oknauta
+// License: MIT
+// File: vulkan_window.cpp
+// Date: 2026-10-19
+
+// Runs without a GPU on lavapipe:
+// VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json ./vulkan_window
+
+#include <vulkan/vulkan.h>
+#include <pc/framework.hpp>
+#include <pc/log.hpp>
+
+int main()
+{
+	// Windows without OpenGL context can present with Vulkan
+	PC::Framework::window_hint(PC::Framework::HINT_CLIENT_API, PC::Framework::CLIENT_API_NONE);
+
+	PC::Framework::window *window = PC::Framework::create_window(800, 600, "Vulkan");
+	if (!window)
+	{
+		PC::Log::error("Failed to create window");
+		return 1;
+	}
+
+	// The instance needs the surface extensions of the framework
+	unsigned int extension_count = 0;
+	const char **extensions = PC::Framework::get_required_instance_extensions(&extension_count);
+
+	VkApplicationInfo application_info = {};
+	application_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+	application_info.pApplicationName = "vulkan_window";
+	application_info.apiVersion = VK_API_VERSION_1_0;
+
+	VkInstanceCreateInfo instance_info = {};
+	instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+	instance_info.pApplicationInfo = &application_info;
+	instance_info.enabledExtensionCount = extension_count;
+	instance_info.ppEnabledExtensionNames = extensions;
+
+	VkInstance instance;
+	if (vkCreateInstance(&instance_info, nullptr, &instance) != VK_SUCCESS)
+	{
+		PC::Log::error("Failed to create Vulkan instance");
+		PC::Framework::destroy_window(window);
+		return 1;
+	}
+
+	VkSurfaceKHR surface;
+	if (PC::Framework::create_vulkan_surface(instance, window, &surface) != 0)
+	{
+		PC::Log::error("Failed to create Vulkan surface");
+		vkDestroyInstance(instance, nullptr);
+		PC::Framework::destroy_window(window);
+		return 1;
+	}
+
+	PC::Log::info("Vulkan surface created");
+
+	while (!PC::Framework::window_should_close(window))
+	{
+		PC::Framework::poll_events(window);
+	}
+
+	vkDestroySurfaceKHR(instance, surface, nullptr);
+	vkDestroyInstance(instance, nullptr);
+	PC::Framework::destroy_window(window);
+
+	return 0;
+}
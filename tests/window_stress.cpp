@@ -0,0 +1,193 @@
+// Author: oknauta
+// License: MIT
+// File: window_stress.cpp
+// Date: 2026-10-19
+
+// Creates and destroys windows many times and fails if fds, X resources or memory grow.
+// Needs libXRes. Runs without a display server on Xvfb:
+// xvfb-run -a ./window_stress 5000
+// xvfb-run -a ./window_stress 5000 none   (windows without OpenGL)
+
+#include <pc/framework.hpp>
+#include <pc/log.hpp>
+#include <X11/Xlib.h>
+#include <X11/extensions/XRes.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Windows created before the baseline is taken, so the caches of Xlib and the driver are already full
+constexpr int WARM_UP = 100;
+// Windows between two reports
+constexpr int BATCH = 250;
+// What the resident memory may grow after the warm-up, in KiB
+constexpr long RSS_TOLERANCE = 4096;
+
+int count_fds()
+{
+	DIR *directory = opendir("/proc/self/fd");
+	if (!directory)
+	{
+		return -1;
+	}
+
+	int count = 0;
+	while (dirent *entry = readdir(directory))
+	{
+		if (entry->d_name[0] != '.')
+		{
+			count++;
+		}
+	}
+
+	closedir(directory);
+
+	// The fd of the directory itself
+	return count - 1;
+}
+
+long resident_kib()
+{
+	FILE *file = fopen("/proc/self/statm", "r");
+	if (!file)
+	{
+		return -1;
+	}
+
+	long size = 0;
+	long resident = 0;
+	if (fscanf(file, "%ld %ld", &size, &resident) != 2)
+	{
+		resident = -1;
+	}
+
+	fclose(file);
+	return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Resources of every client of the server, leaked windows and colormaps of closed connections show here
+long count_x_resources(Display *display)
+{
+	int client_count = 0;
+	XResClient *clients = nullptr;
+	if (!XResQueryClients(display, &client_count, &clients))
+	{
+		return -1;
+	}
+
+	long total = 0;
+	for (int i = 0; i < client_count; i++)
+	{
+		int type_count = 0;
+		XResType *types = nullptr;
+		if (XResQueryClientResources(display, clients[i].resource_base, &type_count, &types))
+		{
+			for (int j = 0; j < type_count; j++)
+			{
+				total += types[j].count;
+			}
+			XFree(types);
+		}
+	}
+
+	XFree(clients);
+
+	// Each client is a resource too
+	return total + client_count;
+}
+
+int main(int argc, char **argv)
+{
+	int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+	if (argc > 2 && strcmp(argv[2], "none") == 0)
+	{
+		PC::Framework::window_hint(PC::Framework::HINT_CLIENT_API, PC::Framework::CLIENT_API_NONE);
+	}
+
+	if (iterations <= WARM_UP)
+	{
+		PC::Log::error("The iterations must be more than %d", WARM_UP);
+		return 1;
+	}
+
+	// A connection of its own to watch the server
+	Display *display = XOpenDisplay(nullptr);
+	if (!display)
+	{
+		PC::Log::error("Failed to open display");
+		return 1;
+	}
+
+	int fds = 0;
+	long resources = 0;
+	long rss = 0;
+
+	std::chrono::steady_clock::time_point batch_start = std::chrono::steady_clock::now();
+
+	for (int i = 1; i <= iterations; i++)
+	{
+		PC::Framework::window *window = PC::Framework::create_window(320, 240, "Stress");
+		if (!window)
+		{
+			PC::Log::error("Failed to create window %d", i);
+			XCloseDisplay(display);
+			return 1;
+		}
+
+		PC::Framework::poll_events(window);
+		PC::Framework::destroy_window(window);
+
+		if (i == WARM_UP)
+		{
+			fds = count_fds();
+			resources = count_x_resources(display);
+			rss = resident_kib();
+			PC::Log::info("Baseline: %d fds, %ld X resources, %ld KiB resident", fds, resources, rss);
+		}
+
+		if (i % BATCH == 0)
+		{
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			double seconds = std::chrono::duration<double>(now - batch_start).count();
+			batch_start = now;
+
+			PC::Log::info("%d windows: %.1f windows/s, %d fds, %ld X resources, %ld KiB resident", i, BATCH / seconds, count_fds(), count_x_resources(display), resident_kib());
+		}
+	}
+
+	int final_fds = count_fds();
+	long final_resources = count_x_resources(display);
+	long final_rss = resident_kib();
+
+	XCloseDisplay(display);
+
+	int result = 0;
+
+	if (final_fds != fds)
+	{
+		PC::Log::error("The fds went from %d to %d", fds, final_fds);
+		result = 1;
+	}
+
+	if (final_resources != resources)
+	{
+		PC::Log::error("The X resources went from %ld to %ld", resources, final_resources);
+		result = 1;
+	}
+
+	if (final_rss - rss > RSS_TOLERANCE)
+	{
+		PC::Log::error("The resident memory went from %ld KiB to %ld KiB", rss, final_rss);
+		result = 1;
+	}
+
+	if (result == 0)
+	{
+		PC::Log::info("%d windows created and destroyed without leaks", iterations);
+	}
+
+	return result;
+}